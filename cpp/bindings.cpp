@@ -20,9 +20,45 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 #include "include/PatientManager.h"
+#include "include/ShardedManager.h"
 
 namespace py = pybind11;
 
+/**
+ * Chunked iterator over the patient set in ID order.
+ *
+ * Each __next__ returns one JSON-array chunk rendered in C++, so
+ * Python can stream a huge listing without ever materializing the
+ * whole payload. Iteration is keyset-based (resumes after the last
+ * ID seen), so each chunk costs O(log n + chunk) regardless of
+ * total record count.
+ */
+struct PatientStream {
+    PatientManager* manager;
+    int chunkSize;
+    int afterId;
+};
+
+/**
+ * Build a native Python dict from a patient record.
+ *
+ * The structured-data path: no JSON formatting in C++ and no
+ * json.loads() in Python - the fields cross the boundary once,
+ * directly into Python objects.
+ */
+static py::dict patientToDict(const Patient& patient) {
+    py::dict d;
+    d["patientId"] = patient.getPatientId();
+    d["name"] = patient.getName();
+    d["age"] = patient.getAge();
+    d["gender"] = patient.getGender();
+    d["disease"] = patient.getDisease();
+    d["contactNumber"] = patient.getContactNumber();
+    d["appointmentDate"] = patient.getAppointmentDate();
+    d["visitNotes"] = patient.getVisitNotes();
+    return d;
+}
+
 /**
  * Python Module Definition
  * 
@@ -31,13 +67,36 @@ namespace py = pybind11;
  */
 PYBIND11_MODULE(patient_system, m) {
     m.doc() = "Patient Management System - Data Structures Implementation";
-    
+
+    // Chunked streaming iterator (created via PatientManager.stream_patients)
+    py::class_<PatientStream>(m, "PatientStream")
+        .def("__iter__",
+             [](PatientStream& self) -> PatientStream& { return self; },
+             py::return_value_policy::reference_internal)
+        .def("__next__",
+             [](PatientStream& self) {
+                 int count = 0;
+                 int lastId = self.afterId;
+                 std::string chunk;
+                 {
+                     py::gil_scoped_release release;
+                     chunk = self.manager->getSortedChunkJSON(
+                         self.afterId, self.chunkSize, count, lastId);
+                 }
+                 if (count == 0) {
+                     throw py::stop_iteration();
+                 }
+                 self.afterId = lastId;
+                 return py::bytes(chunk);
+             });
+
     // Expose PatientManager class to Python
     py::class_<PatientManager>(m, "PatientManager")
         .def(py::init<>())  // Constructor
         
         // ==================== PATIENT OPERATIONS ====================
         .def("add_patient", &PatientManager::addPatient,
+             py::call_guard<py::gil_scoped_release>(),
              "Add a new patient to the system",
              py::arg("name"),
              py::arg("age"),
@@ -48,6 +107,7 @@ PYBIND11_MODULE(patient_system, m) {
              py::arg("visit_notes"))
         
         .def("add_patient_with_id", &PatientManager::addPatientWithId,
+             py::call_guard<py::gil_scoped_release>(),
              "Add a patient with specific ID",
              py::arg("patient_id"),
              py::arg("name"),
@@ -58,15 +118,95 @@ PYBIND11_MODULE(patient_system, m) {
              py::arg("appointment_date"),
              py::arg("visit_notes"))
         
+        .def("bulk_load_patients", &PatientManager::bulkLoadPatients,
+             py::call_guard<py::gil_scoped_release>(),
+             "Bulk load a batch of patient records (skips per-record "
+             "responses and activity logging; builds the index in O(n))",
+             py::arg("records"))
+
         .def("search_patient", &PatientManager::searchPatient,
-             "Search for a patient by ID (uses BST)",
-             py::arg("patient_id"))
+             py::call_guard<py::gil_scoped_release>(),
+             "Search for a patient by ID (pass log_view=False to skip "
+             "the VIEW audit entry on hot read paths)",
+             py::arg("patient_id"),
+             py::arg("log_view") = true)
         
+        .def("search_patient_dict",
+             [](const PatientManager& self, int patient_id) -> py::object {
+                 Patient copy;
+                 bool found;
+                 {
+                     py::gil_scoped_release release;
+                     found = self.getPatientCopy(patient_id, copy);
+                 }
+                 if (!found) {
+                     return py::none();
+                 }
+                 return patientToDict(copy);
+             },
+             "Search for a patient by ID, returning a native dict "
+             "(or None) - no JSON round-trip",
+             py::arg("patient_id"))
+
+        .def("search_patients", &PatientManager::searchPatients,
+             py::call_guard<py::gil_scoped_release>(),
+             "Look up many patients in one crossing (one combined "
+             "JSON response plus the missing IDs)",
+             py::arg("patient_ids"))
+
+        .def("delete_patients", &PatientManager::deletePatients,
+             py::call_guard<py::gil_scoped_release>(),
+             "Delete many patients in one crossing",
+             py::arg("patient_ids"))
+
+        .def("add_to_queue_batch", &PatientManager::addToQueueBatch,
+             py::call_guard<py::gil_scoped_release>(),
+             "Queue many patients in one crossing (default priority)",
+             py::arg("patient_ids"))
+
+        .def("process_appointments", &PatientManager::processAppointments,
+             py::call_guard<py::gil_scoped_release>(),
+             "Process up to max_count appointments in one crossing",
+             py::arg("max_count"))
+
+        .def("search_by_disease", &PatientManager::searchByDisease,
+             py::call_guard<py::gil_scoped_release>(),
+             "Find all patients with a disease (exact match, secondary index)",
+             py::arg("disease"))
+
+        .def("search_by_gender", &PatientManager::searchByGender,
+             py::call_guard<py::gil_scoped_release>(),
+             "Find all patients of a gender (exact match, secondary index)",
+             py::arg("gender"))
+
+        .def("search_by_name", &PatientManager::searchByName,
+             py::call_guard<py::gil_scoped_release>(),
+             "Find all patients whose name starts with a prefix "
+             "(case-insensitive, secondary index)",
+             py::arg("prefix"))
+
+        .def("get_all_patients_list",
+             [](const PatientManager& self) {
+                 std::vector<Patient> snapshot;
+                 {
+                     py::gil_scoped_release release;
+                     snapshot = self.getAllPatientsCopy();
+                 }
+                 py::list out;
+                 for (const Patient& patient : snapshot) {
+                     out.append(patientToDict(patient));
+                 }
+                 return out;
+             },
+             "Get all patients as a native list of dicts - no JSON round-trip")
+
         .def("delete_patient", &PatientManager::deletePatient,
+             py::call_guard<py::gil_scoped_release>(),
              "Delete a patient from the system",
              py::arg("patient_id"))
         
         .def("update_patient", &PatientManager::updatePatient,
+             py::call_guard<py::gil_scoped_release>(),
              "Update patient information",
              py::arg("patient_id"),
              py::arg("name"),
@@ -78,37 +218,197 @@ PYBIND11_MODULE(patient_system, m) {
              py::arg("visit_notes"))
         
         .def("get_all_patients", &PatientManager::getAllPatients,
-             "Get all patients (from linked list)")
+             py::call_guard<py::gil_scoped_release>(),
+             "Get all patients (served from the generation-counter cache)")
+
+        .def("get_all_patients_bytes",
+             [](PatientManager& self) {
+                 // Render (or fetch from cache) with the GIL released,
+                 // then wrap as bytes - skips the UTF-8 decode a str
+                 // return forces
+                 std::string listing;
+                 {
+                     py::gil_scoped_release release;
+                     listing = self.getAllPatients();
+                 }
+                 return py::bytes(listing);
+             },
+             "Get all patients as bytes from the cached JSON buffer")
+
+        .def("export_patients_json",
+             [](PatientManager& self, int threads) {
+                 std::string dump;
+                 {
+                     py::gil_scoped_release release;
+                     dump = self.exportPatientsJSON(threads);
+                 }
+                 return py::bytes(dump);
+             },
+             "Render the full patient set as a JSON array across "
+             "worker threads (0 = all cores) - the nightly-export path",
+             py::arg("threads") = 0)
+
+        .def("get_data_version", &PatientManager::getDataVersion,
+             py::call_guard<py::gil_scoped_release>(),
+             "Monotonic version counter, bumped on every add/update/delete")
         
-        .def("get_patients_sorted", &PatientManager::getPatientsSortedById,
+        .def("get_patients",
+             &PatientManager::getPatients,
+             py::call_guard<py::gil_scoped_release>(),
+             "Get one page of patients (insertion order)",
+             py::arg("offset"),
+             py::arg("limit"))
+
+        .def("get_patients_sorted",
+             py::overload_cast<>(&PatientManager::getPatientsSortedById),
+             py::call_guard<py::gil_scoped_release>(),
              "Get patients sorted by ID (using BST in-order traversal)")
+
+        .def("get_patients_sorted",
+             py::overload_cast<int, int>(&PatientManager::getPatientsSortedById),
+             py::call_guard<py::gil_scoped_release>(),
+             "Get one ID-ordered page starting after the given ID "
+             "(pass the response's lastId back to fetch the next page)",
+             py::arg("after_id"),
+             py::arg("limit"))
+
+        .def("get_patients_in_id_range", &PatientManager::getPatientsInIdRange,
+             py::call_guard<py::gil_scoped_release>(),
+             "Patients with IDs in [lo_id, hi_id), keyset-paginated "
+             "(pass the response's lastId back as after_id)",
+             py::arg("lo_id"),
+             py::arg("hi_id"),
+             py::arg("after_id") = 0,
+             py::arg("limit") = 1000)
+
+        .def("get_appointments_in_window", &PatientManager::getAppointmentsInWindow,
+             py::call_guard<py::gil_scoped_release>(),
+             "Patients with an appointment date in [from, to] "
+             "(inclusive), in date order, one offset/limit page",
+             py::arg("from_date"),
+             py::arg("to_date"),
+             py::arg("offset") = 0,
+             py::arg("limit") = 1000)
+
+        .def("stream_patients",
+             [](PatientManager& self, int chunk_size) {
+                 return PatientStream{&self, chunk_size, 0};
+             },
+             // Keep the manager alive as long as the stream exists
+             py::keep_alive<0, 1>(),
+             "Iterate the patient set in ID order as JSON-array chunks",
+             py::arg("chunk_size") = 1000)
         
+        // ==================== DURABILITY ====================
+        .def("enable_durability", &PatientManager::enableDurability,
+             py::call_guard<py::gil_scoped_release>(),
+             "Recover state from snapshot + WAL in the given directory "
+             "and log every mutation from now on",
+             py::arg("dir"))
+
+        .def("save_snapshot", &PatientManager::saveSnapshot,
+             py::call_guard<py::gil_scoped_release>(),
+             "Write a compact binary snapshot and truncate the WAL")
+
         // ==================== QUEUE OPERATIONS ====================
         .def("add_to_queue", &PatientManager::addToQueue,
-             "Add patient to appointment queue",
+             py::call_guard<py::gil_scoped_release>(),
+             "Add patient to appointment queue (optionally with a triage "
+             "priority - lower is served sooner)",
+             py::arg("patient_id"),
+             py::arg("priority") = AppointmentQueue::DEFAULT_PRIORITY)
+
+        .def("change_queue_priority", &PatientManager::changeQueuePriority,
+             py::call_guard<py::gil_scoped_release>(),
+             "Re-triage a waiting patient to a new priority",
+             py::arg("patient_id"),
+             py::arg("priority"))
+
+        .def("get_queue_position", &PatientManager::getQueuePosition,
+             py::call_guard<py::gil_scoped_release>(),
+             "Get a waiting patient's position in service order",
              py::arg("patient_id"))
-        
+
         .def("process_next_appointment", &PatientManager::processNextAppointment,
-             "Process next appointment in queue (FIFO)")
+             py::call_guard<py::gil_scoped_release>(),
+             "Process the most urgent appointment (FIFO within a priority)")
         
         .def("get_waiting_list", &PatientManager::getWaitingList,
+             py::call_guard<py::gil_scoped_release>(),
              "Get all patients in appointment queue")
         
         .def("peek_next_appointment", &PatientManager::peekNextAppointment,
+             py::call_guard<py::gil_scoped_release>(),
              "Peek at next appointment without processing")
         
         // ==================== STACK OPERATIONS ====================
         .def("get_recent_activities", &PatientManager::getRecentActivities,
+             py::call_guard<py::gil_scoped_release>(),
              "Get recent activities",
              py::arg("count") = 10)
         
         .def("get_all_activities", &PatientManager::getAllActivities,
+             py::call_guard<py::gil_scoped_release>(),
              "Get all activities")
         
         .def("pop_last_activity", &PatientManager::popLastActivity,
+             py::call_guard<py::gil_scoped_release>(),
              "Pop last activity from stack")
+
+        .def("undo_last_operation", &PatientManager::undoLastOperation,
+             py::call_guard<py::gil_scoped_release>(),
+             "Reverse the most recent add/update/delete natively "
+             "(restores the before-image the activity log carries)")
         
         // ==================== STATISTICS ====================
         .def("get_statistics", &PatientManager::getStatistics,
-             "Get system statistics");
+             py::call_guard<py::gil_scoped_release>(),
+             "Get system statistics")
+
+        .def("get_perf_stats", &PatientManager::getPerfStats,
+             py::call_guard<py::gil_scoped_release>(),
+             "Hot-path latency stats (count/avg/p50/p99/max ns per "
+             "operation) from the always-on instrumentation")
+
+        .def("get_aggregates", &PatientManager::getAggregates,
+             py::call_guard<py::gil_scoped_release>(),
+             "Dashboard aggregates (disease/gender frequencies, age "
+             "histogram, appointments per day) from incrementally "
+             "maintained counters - O(distinct values), no record scan");
+
+    // Multi-tenant facade: a fixed array of PatientManager shards
+    // routed by clinic key - per-clinic traffic never contends on
+    // another clinic's lock, cross-shard reads fan out in parallel
+    py::class_<ShardedPatientManager>(m, "ShardedPatientManager")
+        .def(py::init<int>(),
+             "Create a sharded manager (shard_count rounds up to a "
+             "power of two)",
+             py::arg("shard_count") = 16)
+
+        .def("shard_for", &ShardedPatientManager::shardFor,
+             // The shard is owned by the facade - keep it alive
+             py::return_value_policy::reference_internal,
+             "The PatientManager shard owning a clinic key; use the "
+             "full per-clinic API on it",
+             py::arg("clinic_key"))
+
+        .def("get_shard_count", &ShardedPatientManager::getShardCount,
+             "Number of shards")
+
+        .def("get_statistics", &ShardedPatientManager::getStatistics,
+             py::call_guard<py::gil_scoped_release>(),
+             "Cross-shard statistics fan-out (global totals plus the "
+             "per-shard breakdown)")
+
+        .def("export_all_patients_json",
+             [](ShardedPatientManager& self) {
+                 std::string dump;
+                 {
+                     py::gil_scoped_release release;
+                     dump = self.exportAllPatientsJSON();
+                 }
+                 return py::bytes(dump);
+             },
+             "Global export - every shard renders its records on its "
+             "own thread, concatenated into one JSON array");
 }
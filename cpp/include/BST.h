@@ -2,58 +2,68 @@
 #define BST_H
 
 #include "Patient.h"
+#include "NodePool.h"
+#include <climits>
 #include <string>
-#include <sstream>
+#include <utility>
+#include <vector>
 
 /**
- * Binary Search Tree Implementation for Patient ID Search
- * ========================================================
- * 
- * WHY BST?
- * --------
- * 1. Efficient Search: O(log n) average case search time
- *    Much faster than linear search in linked list for large datasets
- * 
- * 2. Sorted Data: In-order traversal gives patients sorted by ID
- *    Useful for generating sorted reports
- * 
- * 3. Dynamic: Can insert and delete without restructuring entire data
- *    Unlike sorted arrays which require shifting elements
- * 
- * 4. Memory Efficient: Only stores what's needed, no pre-allocation
- * 
- * BST PROPERTY:
+ * Self-Balancing (AVL) Binary Search Tree for Patient ID Search
+ * ==============================================================
+ *
+ * WHY A SELF-BALANCING BST?
+ * -------------------------
+ * 1. Guaranteed O(log n) Search: A plain BST degenerates into a
+ *    linked list when keys arrive in sorted order - exactly what
+ *    happens here, because patient IDs are handed out sequentially
+ *    (1001, 1002, 1003, ...). An AVL tree rebalances itself on
+ *    every insert/delete, so the height stays ~1.44*log2(n) no
+ *    matter what order the IDs arrive in.
+ *
+ * 2. Sorted Data: In-order traversal still gives patients sorted
+ *    by ID - useful for generating sorted reports.
+ *
+ * 3. Dynamic: Can insert and delete without restructuring the
+ *    entire data, unlike sorted arrays which require shifting.
+ *
+ * AVL PROPERTY:
  * -------------
- * For every node:
- * - Left subtree contains only nodes with keys LESS than node's key
- * - Right subtree contains only nodes with keys GREATER than node's key
- * 
- * This property enables binary search - at each step, we eliminate 
- * half of the remaining search space.
- * 
+ * For every node, the heights of the left and right subtrees
+ * differ by at most 1 (the "balance factor" is -1, 0, or +1).
+ * Whenever an insert or delete violates this, one or two local
+ * rotations restore it in O(1) per node on the search path.
+ *
+ * THE FOUR ROTATION CASES:
+ * ------------------------
+ * - Left-Left   (balance > 1, key in left-left):   rotate right
+ * - Right-Right (balance < -1, key in right-right): rotate left
+ * - Left-Right  (balance > 1, key in left-right):  rotate left then right
+ * - Right-Left  (balance < -1, key in right-left): rotate right then left
+ *
  * REAL-WORLD ANALOGY:
  * -------------------
- * Think of a dictionary - you don't search page by page. You open 
- * roughly in the middle, check if your word comes before or after, 
- * then repeat in the appropriate half.
- * 
+ * Think of a mobile (hanging sculpture) that re-levels itself
+ * whenever you hang a new ornament on one side - no arm is ever
+ * allowed to get much longer than its sibling.
+ *
  * TIME COMPLEXITY:
  * ----------------
- * - Insert:              O(log n) average, O(n) worst (skewed tree)
- * - Search:              O(log n) average, O(n) worst (skewed tree)
- * - Delete:              O(log n) average, O(n) worst
+ * - Insert:              O(log n) guaranteed (search + rotations)
+ * - Search:              O(log n) guaranteed
+ * - Delete:              O(log n) guaranteed
  * - In-order Traversal:  O(n)
- * 
+ *
  * SPACE COMPLEXITY:
  * -----------------
- * - O(n) for n patients
- * - Recursive operations use O(h) stack space where h = tree height
+ * - O(n) for n patients (one extra int per node for height)
+ * - Recursive operations use O(log n) stack space
  */
 
 class PatientBST {
 private:
     /**
-     * BST Node Implementation
+     * AVL Node Implementation
      * -----------------------
      * Encapsulated as a private inner struct/class.
      * Hidden from the outside world, accessible only by PatientBST.
@@ -63,11 +73,13 @@ private:
         Patient* patient;   // Pointer to patient data (stored in linked list)
         BSTNode* left;      // Left child (smaller IDs)
         BSTNode* right;     // Right child (larger IDs)
+        int height;         // Height of subtree rooted here (leaf = 1)
 
-        BSTNode(int id, Patient* p) 
-            : patientId(id), patient(p), left(nullptr), right(nullptr) {}
+        BSTNode(int id, Patient* p)
+            : patientId(id), patient(p), left(nullptr), right(nullptr), height(1) {}
     };
 
+    NodePool<BSTNode> nodePool;  // Slab allocator for nodes
     BSTNode* root;  // Root of the BST
     int size;       // Number of nodes
 
@@ -78,37 +90,37 @@ public:
     PatientBST() : root(nullptr), size(0) {}
 
     /**
-     * Destructor - Free all nodes
+     * Destructor - Nodes are trivially destructible (ints and
+     * pointers only), so the pool's wholesale block teardown frees
+     * everything; no per-node traversal needed.
      */
-    ~PatientBST() {
-        destroyTree(root);
-    }
+    ~PatientBST() {}
 
     /**
      * Insert patient ID into BST
-     * 
+     *
      * @param patientId The patient ID to insert
      * @param patient Pointer to the patient data
      * @return true if inserted, false if ID already exists
-     * 
-     * Time: O(log n) average, O(n) worst | Space: O(h) for recursion
+     *
+     * Time: O(log n) guaranteed, single descent | Space: O(log n) for recursion
      */
     bool insert(int patientId, Patient* patient) {
-        if (search(patientId) != nullptr) {
-            return false; // ID already exists
+        bool inserted = false;
+        root = insertRecursive(root, patientId, patient, inserted);
+        if (inserted) {
+            size++;
         }
-        root = insertRecursive(root, patientId, patient);
-        size++;
-        return true;
+        return inserted;
     }
 
     /**
      * Search for patient by ID
-     * 
+     *
      * @param patientId The ID to search for
      * @return Pointer to patient if found, nullptr otherwise
-     * 
-     * Time: O(log n) average, O(n) worst | Space: O(h) for recursion
+     *
+     * Time: O(log n) guaranteed | Space: O(log n) for recursion
      */
     Patient* search(int patientId) const {
         BSTNode* node = searchRecursive(root, patientId);
@@ -120,48 +132,125 @@ public:
 
     /**
      * Delete patient ID from BST
-     * 
+     *
      * @param patientId The ID to delete
      * @return true if deleted, false if not found
-     * 
-     * Time: O(log n) average | Space: O(h) for recursion
+     *
+     * Time: O(log n) guaranteed, single descent | Space: O(log n) for recursion
      */
     bool remove(int patientId) {
-        if (search(patientId) == nullptr) {
-            return false; // ID not found
+        bool removed = false;
+        root = deleteRecursive(root, patientId, removed);
+        if (removed) {
+            size--;
         }
-        root = deleteRecursive(root, patientId);
-        size--;
+        return removed;
+    }
+
+    /**
+     * Build a perfectly balanced tree from entries sorted by ID
+     *
+     * Used by bulk loading: instead of n O(log n) inserts with
+     * rotations, the tree is assembled bottom-up by repeatedly
+     * taking the middle element as the subtree root - the same way
+     * you'd binary-search the array.
+     *
+     * @param sorted (patientId, Patient*) pairs in ascending ID order
+     * @return true if built, false if the tree was not empty
+     *
+     * Time: O(n) | Space: O(log n) for recursion
+     */
+    bool buildFromSorted(const std::vector<std::pair<int, Patient*>>& sorted) {
+        if (root != nullptr) {
+            return false;  // Only valid on an empty tree
+        }
+        root = buildBalanced(sorted, 0, static_cast<int>(sorted.size()) - 1);
+        size = static_cast<int>(sorted.size());
         return true;
     }
 
     /**
      * In-order traversal - returns patients sorted by ID
      * Visits: Left subtree -> Node -> Right subtree
-     * 
+     *
      * @return JSON array of patient IDs in sorted order
-     * 
-     * Time: O(n) | Space: O(n) for output + O(h) for recursion
+     *
+     * Time: O(n) | Space: O(n) for output + O(log n) for recursion
      */
     std::string inorderTraversalJSON() const {
-        std::stringstream ss;
-        ss << "[";
+        std::string out;
+        out.reserve(static_cast<std::size_t>(size) * 8 + 2);
+        out += "[";
         bool first = true;
-        inorderHelper(root, ss, first);
-        ss << "]";
-        return ss.str();
+        inorderHelper(root, out, first);
+        out += "]";
+        return out;
     }
 
     /**
      * Get all patients in sorted order (by ID) as JSON
      */
     std::string getSortedPatientsJSON() const {
-        std::stringstream ss;
-        ss << "[";
+        std::string out;
+        out.reserve(static_cast<std::size_t>(size) * 192 + 2);
+        out += "[";
+        bool first = true;
+        inorderPatientsHelper(root, out, first);
+        out += "]";
+        return out;
+    }
+
+    /**
+     * Get up to 'limit' patients with ID greater than 'afterId',
+     * in ascending ID order, as a JSON array
+     *
+     * Subtrees entirely at or below 'afterId' are pruned and the
+     * walk stops as soon as 'limit' records are emitted, so the
+     * cost is O(log n + limit) regardless of tree size. 'count'
+     * and 'lastId' report how many were emitted and the highest ID
+     * seen, which lets callers resume iteration where they left off.
+     */
+    std::string getSortedPatientsAfterJSON(int afterId, int limit,
+                                           int& count, int& lastId) const {
+        std::string out;
+        out.reserve(static_cast<std::size_t>(limit > 0 ? limit : 0) * 192 + 2);
+        out += "[";
+        bool first = true;
+        count = 0;
+        lastId = afterId;
+        collectAfter(root, afterId, limit, out, count, lastId, first);
+        out += "]";
+        return out;
+    }
+
+    /**
+     * Get up to 'limit' patients with ID in [loId, hiId), resuming
+     * after 'afterId', in ascending ID order, as a JSON array
+     *
+     * The walk prunes both ends: subtrees entirely below the lower
+     * cutoff or entirely at/above 'hiId' are never visited, and it
+     * stops at 'limit' - O(log n + limit) however large the tree.
+     * 'count'/'lastId' support the same keyset pagination as
+     * getSortedPatientsAfterJSON.
+     */
+    std::string searchRangeJSON(int loId, int hiId, int afterId, int limit,
+                                int& count, int& lastId) const {
+        // Emit IDs strictly above the cutoff: the range start and
+        // the resume point collapse into one lower bound. Guard the
+        // loId - 1 when loId == INT_MIN - the subtraction would be
+        // signed overflow, and an INT_MIN range start excludes
+        // nothing anyway, so the resume point alone is the cutoff.
+        int above = (loId != INT_MIN && loId - 1 > afterId) ? loId - 1 : afterId;
+
+        std::string out;
+        out.reserve(static_cast<std::size_t>(limit > 0 ? limit : 0) * 192 + 2);
+        out += "[";
         bool first = true;
-        inorderPatientsHelper(root, ss, first);
-        ss << "]";
-        return ss.str();
+        count = 0;
+        lastId = afterId;
+        collectRange(root, above, hiId, limit, out, count, lastId, first);
+        out += "]";
+        return out;
     }
 
     /**
@@ -180,11 +269,12 @@ public:
 
     /**
      * Get tree height (for complexity analysis)
-     * 
-     * Time: O(n) | Space: O(h)
+     * With AVL balancing this stays ~1.44*log2(n).
+     *
+     * Time: O(1) - height is maintained on every insert/delete
      */
     int getHeight() const {
-        return heightHelper(root);
+        return nodeHeight(root);
     }
 
     /**
@@ -199,23 +289,136 @@ public:
 
 private:
     /**
-     * Recursive insert helper
+     * Height of a subtree (nullptr counts as 0)
+     */
+    int nodeHeight(BSTNode* node) const {
+        return (node == nullptr) ? 0 : node->height;
+    }
+
+    /**
+     * Balance factor = height(left) - height(right)
+     * AVL invariant: must be -1, 0, or +1 for every node
+     */
+    int balanceFactor(BSTNode* node) const {
+        return (node == nullptr) ? 0 : nodeHeight(node->left) - nodeHeight(node->right);
+    }
+
+    /**
+     * Recompute a node's height from its children
+     */
+    void updateHeight(BSTNode* node) {
+        int leftHeight = nodeHeight(node->left);
+        int rightHeight = nodeHeight(node->right);
+        node->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+    }
+
+    /**
+     * Right rotation (fixes Left-Left imbalance)
+     *
+     *        y                x
+     *       / \              / \
+     *      x   C    -->     A   y
+     *     / \                  / \
+     *    A   B                B   C
+     */
+    BSTNode* rotateRight(BSTNode* y) {
+        BSTNode* x = y->left;
+        BSTNode* B = x->right;
+
+        x->right = y;
+        y->left = B;
+
+        updateHeight(y);  // y is now below x, update it first
+        updateHeight(x);
+
+        return x;  // New subtree root
+    }
+
+    /**
+     * Left rotation (fixes Right-Right imbalance) - mirror of rotateRight
      */
-    BSTNode* insertRecursive(BSTNode* node, int patientId, Patient* patient) {
+    BSTNode* rotateLeft(BSTNode* x) {
+        BSTNode* y = x->right;
+        BSTNode* B = y->left;
+
+        y->left = x;
+        x->right = B;
+
+        updateHeight(x);
+        updateHeight(y);
+
+        return y;  // New subtree root
+    }
+
+    /**
+     * Restore the AVL invariant at this node after an insert/delete
+     * somewhere below it. At most two rotations are needed.
+     */
+    BSTNode* rebalance(BSTNode* node) {
+        updateHeight(node);
+        int balance = balanceFactor(node);
+
+        // Left side too tall
+        if (balance > 1) {
+            if (balanceFactor(node->left) < 0) {
+                node->left = rotateLeft(node->left);  // Left-Right case
+            }
+            return rotateRight(node);  // Left-Left case
+        }
+
+        // Right side too tall
+        if (balance < -1) {
+            if (balanceFactor(node->right) > 0) {
+                node->right = rotateRight(node->right);  // Right-Left case
+            }
+            return rotateLeft(node);  // Right-Right case
+        }
+
+        return node;  // Already balanced
+    }
+
+    /**
+     * Bottom-up balanced construction helper: the middle element of
+     * each range becomes the subtree root, so the result is as flat
+     * as a tree over these keys can be.
+     */
+    BSTNode* buildBalanced(const std::vector<std::pair<int, Patient*>>& sorted,
+                           int lo, int hi) {
+        if (lo > hi) return nullptr;
+
+        int mid = lo + (hi - lo) / 2;
+        BSTNode* node = new (nodePool.grab()) BSTNode(sorted[mid].first,
+                                                      sorted[mid].second);
+        node->left = buildBalanced(sorted, lo, mid - 1);
+        node->right = buildBalanced(sorted, mid + 1, hi);
+        updateHeight(node);
+        return node;
+    }
+
+    /**
+     * Recursive insert helper with rebalancing on the way back up.
+     * Duplicates are detected during the descent itself (reported
+     * via the 'inserted' out-parameter), so no separate search pass
+     * is needed before inserting.
+     */
+    BSTNode* insertRecursive(BSTNode* node, int patientId, Patient* patient,
+                             bool& inserted) {
         // Base case: empty position found
         if (node == nullptr) {
-            return new BSTNode(patientId, patient);
+            inserted = true;
+            return new (nodePool.grab()) BSTNode(patientId, patient);
         }
 
         // Recursively find correct position
         if (patientId < node->patientId) {
-            node->left = insertRecursive(node->left, patientId, patient);
+            node->left = insertRecursive(node->left, patientId, patient, inserted);
         } else if (patientId > node->patientId) {
-            node->right = insertRecursive(node->right, patientId, patient);
+            node->right = insertRecursive(node->right, patientId, patient, inserted);
+        } else {
+            return node;  // Duplicate - nothing changed, no rebalance needed
         }
-        // If equal, do nothing (duplicate)
 
-        return node;
+        return rebalance(node);
     }
 
     /**
@@ -235,34 +438,37 @@ private:
     }
 
     /**
-     * Recursive delete helper
+     * Recursive delete helper with rebalancing on the way back up.
+     * Absence is detected during the descent (reported via the
+     * 'removed' out-parameter) - no separate search pass.
      */
-    BSTNode* deleteRecursive(BSTNode* node, int patientId) {
-        if (node == nullptr) return nullptr;
+    BSTNode* deleteRecursive(BSTNode* node, int patientId, bool& removed) {
+        if (node == nullptr) return nullptr;  // Key not in tree
 
         // Find the node to delete
         if (patientId < node->patientId) {
-            node->left = deleteRecursive(node->left, patientId);
+            node->left = deleteRecursive(node->left, patientId, removed);
         } else if (patientId > node->patientId) {
-            node->right = deleteRecursive(node->right, patientId);
+            node->right = deleteRecursive(node->right, patientId, removed);
         } else {
             // Found node to delete
+            removed = true;
 
             // Case 1: Leaf node
             if (node->left == nullptr && node->right == nullptr) {
-                delete node;
+                nodePool.release(node);
                 return nullptr;
             }
 
             // Case 2: One child
             if (node->left == nullptr) {
                 BSTNode* temp = node->right;
-                delete node;
+                nodePool.release(node);
                 return temp;
             }
             if (node->right == nullptr) {
                 BSTNode* temp = node->left;
-                delete node;
+                nodePool.release(node);
                 return temp;
             }
 
@@ -271,10 +477,12 @@ private:
             BSTNode* successor = findMin(node->right);
             node->patientId = successor->patientId;
             node->patient = successor->patient;
-            node->right = deleteRecursive(node->right, successor->patientId);
+            bool successorRemoved = false;  // Always succeeds - successor exists
+            node->right = deleteRecursive(node->right, successor->patientId,
+                                          successorRemoved);
         }
 
-        return node;
+        return rebalance(node);
     }
 
     /**
@@ -288,55 +496,97 @@ private:
     }
 
     /**
-     * In-order traversal helper (IDs only)
+     * Pruned in-order walk for paginated iteration: skips subtrees
+     * that cannot contain IDs above 'afterId' and bails out once
+     * 'limit' records have been emitted.
      */
-    void inorderHelper(BSTNode* node, std::stringstream& ss, bool& first) const {
-        if (node == nullptr) return;
+    void collectAfter(BSTNode* node, int afterId, int limit,
+                      std::string& out, int& count, int& lastId,
+                      bool& first) const {
+        if (node == nullptr || count >= limit) return;
+
+        // Left subtree only matters if this node is above the cutoff
+        if (node->patientId > afterId) {
+            collectAfter(node->left, afterId, limit, out, count, lastId, first);
+        }
 
-        inorderHelper(node->left, ss, first);
-        
-        if (!first) ss << ",";
-        ss << node->patientId;
-        first = false;
+        if (count >= limit) return;
 
-        inorderHelper(node->right, ss, first);
+        if (node->patientId > afterId && node->patient != nullptr) {
+            if (!first) out += ",";
+            node->patient->appendJSON(out);
+            first = false;
+            count++;
+            lastId = node->patientId;
+        }
+
+        collectAfter(node->right, afterId, limit, out, count, lastId, first);
     }
 
     /**
-     * In-order traversal helper (full patient data)
+     * Doubly pruned in-order walk for range queries: 'above' is the
+     * exclusive lower bound, 'hiId' the exclusive upper bound
      */
-    void inorderPatientsHelper(BSTNode* node, std::stringstream& ss, bool& first) const {
-        if (node == nullptr) return;
+    void collectRange(BSTNode* node, int above, int hiId, int limit,
+                      std::string& out, int& count, int& lastId,
+                      bool& first) const {
+        if (node == nullptr || count >= limit) return;
+
+        // Left subtree only matters if this node is above the cutoff
+        if (node->patientId > above) {
+            collectRange(node->left, above, hiId, limit, out, count, lastId,
+                         first);
+        }
 
-        inorderPatientsHelper(node->left, ss, first);
-        
-        if (node->patient != nullptr) {
-            if (!first) ss << ",";
-            ss << node->patient->toJSON();
+        if (count >= limit) return;
+
+        if (node->patientId > above && node->patientId < hiId &&
+            node->patient != nullptr) {
+            if (!first) out += ",";
+            node->patient->appendJSON(out);
             first = false;
+            count++;
+            lastId = node->patientId;
         }
 
-        inorderPatientsHelper(node->right, ss, first);
+        // Right subtree holds only larger IDs - prune it once this
+        // node has reached the upper bound
+        if (node->patientId < hiId) {
+            collectRange(node->right, above, hiId, limit, out, count, lastId,
+                         first);
+        }
     }
 
     /**
-     * Height helper
+     * In-order traversal helper (IDs only)
      */
-    int heightHelper(BSTNode* node) const {
-        if (node == nullptr) return 0;
-        int leftHeight = heightHelper(node->left);
-        int rightHeight = heightHelper(node->right);
-        return 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+    void inorderHelper(BSTNode* node, std::string& out, bool& first) const {
+        if (node == nullptr) return;
+
+        inorderHelper(node->left, out, first);
+
+        if (!first) out += ",";
+        jsonutil::appendInt(out, node->patientId);
+        first = false;
+
+        inorderHelper(node->right, out, first);
     }
 
     /**
-     * Destroy tree helper (post-order deletion)
+     * In-order traversal helper (full patient data)
      */
-    void destroyTree(BSTNode* node) {
+    void inorderPatientsHelper(BSTNode* node, std::string& out, bool& first) const {
         if (node == nullptr) return;
-        destroyTree(node->left);
-        destroyTree(node->right);
-        delete node;
+
+        inorderPatientsHelper(node->left, out, first);
+
+        if (node->patient != nullptr) {
+            if (!first) out += ",";
+            node->patient->appendJSON(out);
+            first = false;
+        }
+
+        inorderPatientsHelper(node->right, out, first);
     }
 };
 
@@ -0,0 +1,401 @@
+#ifndef HASH_MAP_H
+#define HASH_MAP_H
+
+#include "Patient.h"
+#include "LinkedList.h"  // PatientNode - the map stores node handles
+
+/**
+ * Open-Addressing Hash Map for O(1) Patient Lookups
+ * ==================================================
+ *
+ * WHY A HASH MAP (ON TOP OF THE BST)?
+ * -----------------------------------
+ * 1. O(1) Point Lookups: Even a balanced tree costs ~log2(n)
+ *    pointer-chasing cache misses per search. A hash map resolves
+ *    a patient ID to its record in one or two probes on average.
+ *
+ * 2. Read-Heavy Workload: searchPatient dominates call volume,
+ *    so the structure serving it should be the fastest we have.
+ *    The BST is kept alongside purely for sorted traversal.
+ *
+ * 3. Open Addressing (not chaining): All entries live in one
+ *    contiguous array, so probing stays within a cache line or
+ *    two - no per-entry heap allocation, no pointer chasing.
+ *
+ * COLLISION STRATEGY:
+ * -------------------
+ * Linear probing with tombstones:
+ * - Insert: hash the key, walk forward until an empty/deleted
+ *   slot is found
+ * - Search: walk forward until the key or an empty slot is found
+ * - Delete: mark the slot DELETED (a "tombstone") so probe chains
+ *   passing through it stay intact
+ * The table is rebuilt at 70% occupancy (counting tombstones), so
+ * probe chains stay short.
+ *
+ * REAL-WORLD ANALOGY:
+ * -------------------
+ * A coat check: your ticket number tells the attendant exactly
+ * which hook to walk to. If that hook is taken, the coat hangs on
+ * the next free hook - still one short walk, not a search of the
+ * whole cloakroom.
+ *
+ * TIME COMPLEXITY:
+ * ----------------
+ * - Insert:  O(1) average, amortized over occasional rehash
+ * - Search:  O(1) average
+ * - Delete:  O(1) average
+ *
+ * SPACE COMPLEXITY:
+ * -----------------
+ * - O(capacity), kept within ~2x the number of live entries
+ */
+
+class PatientHashMap {
+private:
+    // Slot states for open addressing
+    enum SlotState : unsigned char {
+        EMPTY,    // Never used - terminates probe chains
+        OCCUPIED, // Holds a live entry
+        DELETED   // Tombstone - probe chains continue through it
+    };
+
+    // One slot of the table (kept flat for cache friendliness).
+    // The value is the LIST NODE handle, not just the Patient: the
+    // node is what an O(1) unlink or in-place update needs, and the
+    // Patient is reachable as &node->data.
+    struct Slot {
+        int key;
+        PatientNode* value;
+        SlotState state;
+
+        Slot() : key(0), value(nullptr), state(EMPTY) {}
+    };
+
+    Slot* table;       // Contiguous slot array
+    int capacity;      // Always a power of two (enables mask-based modulo)
+    int count;         // Live entries
+    int usedSlots;     // Live entries + tombstones (drives rehash)
+
+    static const int INITIAL_CAPACITY = 64;
+
+public:
+    /**
+     * Constructor - Initialize empty table
+     */
+    PatientHashMap() : capacity(INITIAL_CAPACITY), count(0), usedSlots(0) {
+        table = new Slot[capacity];
+    }
+
+    /**
+     * Destructor - One contiguous array, one delete
+     */
+    ~PatientHashMap() {
+        delete[] table;
+    }
+
+    // Non-copyable (owns a raw buffer)
+    PatientHashMap(const PatientHashMap&) = delete;
+    PatientHashMap& operator=(const PatientHashMap&) = delete;
+
+    /**
+     * Insert or overwrite a key -> list-node mapping
+     *
+     * @return true if a new entry was created, false if the key
+     *         already existed (its value is updated in place)
+     *
+     * Time: O(1) average
+     */
+    bool insert(int key, PatientNode* value) {
+        if ((usedSlots + 1) * 10 >= capacity * 7) {
+            rehash(capacity * 2);
+        }
+
+        int index = probeFor(key);
+        if (table[index].state == OCCUPIED) {
+            table[index].value = value;  // Key exists - update pointer
+            return false;
+        }
+
+        if (table[index].state == EMPTY) {
+            usedSlots++;
+        }
+        table[index].key = key;
+        table[index].value = value;
+        table[index].state = OCCUPIED;
+        count++;
+        return true;
+    }
+
+    /**
+     * Look up a patient by ID
+     *
+     * @return Pointer to patient if found, nullptr otherwise
+     *
+     * Time: O(1) average
+     */
+    Patient* search(int key) const {
+        PatientNode* node = searchNode(key);
+        return (node != nullptr) ? &node->data : nullptr;
+    }
+
+    /**
+     * Look up the list node holding a patient - the handle for
+     * O(1) unlink and in-place update
+     *
+     * Time: O(1) average
+     */
+    PatientNode* searchNode(int key) const {
+        int index = probeFor(key);
+        if (table[index].state == OCCUPIED) {
+            return table[index].value;
+        }
+        return nullptr;
+    }
+
+    /**
+     * Check if a patient ID is present
+     *
+     * Time: O(1) average
+     */
+    bool contains(int key) const {
+        return search(key) != nullptr;
+    }
+
+    /**
+     * Remove a key from the table (leaves a tombstone)
+     *
+     * @return true if removed, false if the key was not present
+     *
+     * Time: O(1) average
+     */
+    bool remove(int key) {
+        int index = probeFor(key);
+        if (table[index].state != OCCUPIED) {
+            return false;
+        }
+        table[index].value = nullptr;
+        table[index].state = DELETED;
+        count--;
+        return true;
+    }
+
+    /**
+     * Get number of live entries
+     */
+    int getSize() const {
+        return count;
+    }
+
+    /**
+     * Check if table is empty
+     */
+    bool isEmpty() const {
+        return count == 0;
+    }
+
+private:
+    /**
+     * Integer hash (Fibonacci multiplication + xor-fold)
+     * Scrambles sequential IDs so they don't cluster in the table.
+     */
+    unsigned int hashKey(int key) const {
+        unsigned int h = static_cast<unsigned int>(key);
+        h ^= h >> 16;
+        h *= 0x9E3779B9u;  // 2^32 / golden ratio
+        h ^= h >> 15;
+        return h;
+    }
+
+    /**
+     * Find the slot for a key: either the slot holding it, or the
+     * first insertable (empty/deleted) slot on its probe chain.
+     */
+    int probeFor(int key) const {
+        unsigned int mask = static_cast<unsigned int>(capacity - 1);
+        unsigned int index = hashKey(key) & mask;
+        int firstDeleted = -1;
+
+        while (true) {
+            const Slot& slot = table[index];
+            if (slot.state == EMPTY) {
+                return (firstDeleted >= 0) ? firstDeleted : static_cast<int>(index);
+            }
+            if (slot.state == OCCUPIED && slot.key == key) {
+                return static_cast<int>(index);
+            }
+            if (slot.state == DELETED && firstDeleted < 0) {
+                firstDeleted = static_cast<int>(index);
+            }
+            index = (index + 1) & mask;  // Linear probe, wraps around
+        }
+    }
+
+    /**
+     * Grow the table and reinsert all live entries
+     * (tombstones are discarded here, which keeps chains short)
+     *
+     * Time: O(n), amortized O(1) per insert
+     */
+    void rehash(int newCapacity) {
+        Slot* oldTable = table;
+        int oldCapacity = capacity;
+
+        table = new Slot[newCapacity];
+        capacity = newCapacity;
+        count = 0;
+        usedSlots = 0;
+
+        for (int i = 0; i < oldCapacity; i++) {
+            if (oldTable[i].state == OCCUPIED) {
+                insert(oldTable[i].key, oldTable[i].value);
+            }
+        }
+        delete[] oldTable;
+    }
+};
+
+/**
+ * Open-addressing hash set of ints (same probing scheme as
+ * PatientHashMap, minus the value column) - used for O(1)
+ * membership questions like "is this patient already queued?"
+ */
+class IntHashSet {
+private:
+    enum SlotState : unsigned char { EMPTY, OCCUPIED, DELETED };
+
+    struct Slot {
+        int key;
+        SlotState state;
+
+        Slot() : key(0), state(EMPTY) {}
+    };
+
+    Slot* table;
+    int capacity;   // Always a power of two
+    int count;      // Live entries
+    int usedSlots;  // Live entries + tombstones
+
+    static const int INITIAL_CAPACITY = 64;
+
+public:
+    IntHashSet() : capacity(INITIAL_CAPACITY), count(0), usedSlots(0) {
+        table = new Slot[capacity];
+    }
+
+    ~IntHashSet() {
+        delete[] table;
+    }
+
+    IntHashSet(const IntHashSet&) = delete;
+    IntHashSet& operator=(const IntHashSet&) = delete;
+
+    /**
+     * Add a key
+     *
+     * @return true if newly added, false if already present
+     *
+     * Time: O(1) average
+     */
+    bool add(int key) {
+        if ((usedSlots + 1) * 10 >= capacity * 7) {
+            rehash(capacity * 2);
+        }
+
+        int index = probeFor(key);
+        if (table[index].state == OCCUPIED) {
+            return false;
+        }
+        if (table[index].state == EMPTY) {
+            usedSlots++;
+        }
+        table[index].key = key;
+        table[index].state = OCCUPIED;
+        count++;
+        return true;
+    }
+
+    /**
+     * Remove a key
+     *
+     * @return true if it was present
+     *
+     * Time: O(1) average
+     */
+    bool remove(int key) {
+        int index = probeFor(key);
+        if (table[index].state != OCCUPIED) {
+            return false;
+        }
+        table[index].state = DELETED;  // Tombstone keeps chains intact
+        count--;
+        return true;
+    }
+
+    /**
+     * Membership check
+     *
+     * Time: O(1) average
+     */
+    bool contains(int key) const {
+        return table[probeFor(key)].state == OCCUPIED;
+    }
+
+    /**
+     * Number of keys in the set
+     */
+    int getSize() const {
+        return count;
+    }
+
+private:
+    /**
+     * Same Fibonacci hash as PatientHashMap
+     */
+    unsigned int hashKey(int key) const {
+        unsigned int h = static_cast<unsigned int>(key);
+        h ^= h >> 16;
+        h *= 0x9E3779B9u;
+        h ^= h >> 15;
+        return h;
+    }
+
+    int probeFor(int key) const {
+        unsigned int mask = static_cast<unsigned int>(capacity - 1);
+        unsigned int index = hashKey(key) & mask;
+        int firstDeleted = -1;
+
+        while (true) {
+            const Slot& slot = table[index];
+            if (slot.state == EMPTY) {
+                return (firstDeleted >= 0) ? firstDeleted : static_cast<int>(index);
+            }
+            if (slot.state == OCCUPIED && slot.key == key) {
+                return static_cast<int>(index);
+            }
+            if (slot.state == DELETED && firstDeleted < 0) {
+                firstDeleted = static_cast<int>(index);
+            }
+            index = (index + 1) & mask;
+        }
+    }
+
+    void rehash(int newCapacity) {
+        Slot* oldTable = table;
+        int oldCapacity = capacity;
+
+        table = new Slot[newCapacity];
+        capacity = newCapacity;
+        count = 0;
+        usedSlots = 0;
+
+        for (int i = 0; i < oldCapacity; i++) {
+            if (oldTable[i].state == OCCUPIED) {
+                add(oldTable[i].key);
+            }
+        }
+        delete[] oldTable;
+    }
+};
+
+#endif // HASH_MAP_H
@@ -0,0 +1,185 @@
+#ifndef INTERN_H
+#define INTERN_H
+
+#include <mutex>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Global String Interning Pool
+ * ============================
+ *
+ * WHY INTERN PATIENT FIELDS?
+ * --------------------------
+ * In real data, gender has ~3 distinct values, disease a few
+ * hundred and appointmentDate about one per clinic day - yet a
+ * naive Patient stores millions of independent heap copies of the
+ * same few strings. Interning replaces each copy with a 32-bit
+ * handle into one shared pool:
+ *
+ * 1. Memory: A field shrinks from a full std::string (32 bytes +
+ *    heap buffer) to 4 bytes, and each distinct value is stored
+ *    exactly once process-wide.
+ *
+ * 2. Equality Is An Integer Compare: Two fields hold the same
+ *    value if and only if their handles are equal - no character
+ *    comparison, which the secondary indexes can exploit.
+ *
+ * 3. Copying Is Free: Snapshotting or moving a record copies the
+ *    handle, not the characters.
+ *
+ * THREAD SAFETY:
+ * --------------
+ * - intern() takes a mutex - it runs on write paths, which the
+ *   manager already serializes.
+ * - get() is lock-free: values live in fixed-size chunks whose
+ *   addresses never change once allocated, so resolving a handle
+ *   is two array indexes. A handle only reaches a reader through
+ *   the manager's reader-writer lock, which orders the pool write
+ *   before the read.
+ * - Values are never removed. The pool is append-only and
+ *   bounded by the number of DISTINCT values, not records.
+ */
+
+namespace intern {
+
+class InternPool {
+private:
+    // Values live in fixed 1024-string chunks; chunk addresses are
+    // stable forever, so get() needs no lock
+    static const unsigned int CHUNK_BITS = 10;
+    static const unsigned int CHUNK_SIZE = 1u << CHUNK_BITS;
+    static const unsigned int MAX_CHUNKS = 4096;  // ~4.2M distinct values
+
+    std::string* chunks[MAX_CHUNKS];
+    unsigned int count;  // Distinct values stored (== next handle)
+
+    // Open-addressing value -> handle table (same scheme as the
+    // other hash structures: power-of-two capacity, linear probe;
+    // no tombstones - values are never removed)
+    unsigned int* table;  // Stores handle + 1; 0 marks an empty slot
+    unsigned int capacity;
+
+    std::mutex mutex;  // Guards intern() only
+
+public:
+    InternPool() : count(0), capacity(1024) {
+        for (unsigned int i = 0; i < MAX_CHUNKS; i++) chunks[i] = nullptr;
+        table = new unsigned int[capacity]();
+        intern("");  // Handle 0 is always the empty string
+    }
+
+    ~InternPool() {
+        for (unsigned int i = 0; i < MAX_CHUNKS && chunks[i] != nullptr; i++) {
+            delete[] chunks[i];
+        }
+        delete[] table;
+    }
+
+    InternPool(const InternPool&) = delete;
+    InternPool& operator=(const InternPool&) = delete;
+
+    /**
+     * Map a value to its handle, storing it on first sight
+     *
+     * Time: O(1) average (hash probe; one string copy only for a
+     * value the pool has never seen)
+     */
+    unsigned int intern(const std::string& value) {
+        std::lock_guard<std::mutex> lock(mutex);
+
+        unsigned int mask = capacity - 1;
+        unsigned int index = hashString(value) & mask;
+        while (table[index] != 0) {
+            unsigned int handle = table[index] - 1;
+            if (valueAt(handle) == value) {
+                return handle;
+            }
+            index = (index + 1) & mask;
+        }
+
+        // New value - store it and publish the handle
+        unsigned int handle = count;
+        unsigned int chunk = handle >> CHUNK_BITS;
+        if (chunk >= MAX_CHUNKS) {
+            // The pool is full (~4.2M DISTINCT values - far beyond
+            // real gender/disease/date cardinality, but these are
+            // caller-supplied fields). Fail loudly rather than
+            // write past the fixed chunk array.
+            throw std::length_error(
+                "InternPool: distinct-value capacity exhausted");
+        }
+        if (chunks[chunk] == nullptr) {
+            chunks[chunk] = new std::string[CHUNK_SIZE];
+        }
+        chunks[chunk][handle & (CHUNK_SIZE - 1)] = value;
+        count++;
+        table[index] = handle + 1;
+
+        if (count * 10 >= capacity * 7) {
+            rehash(capacity * 2);
+        }
+        return handle;
+    }
+
+    /**
+     * Resolve a handle back to its value - lock-free, two array
+     * indexes (the getter hot path)
+     */
+    const std::string& get(unsigned int handle) const {
+        return chunks[handle >> CHUNK_BITS][handle & (CHUNK_SIZE - 1)];
+    }
+
+    /**
+     * Number of distinct values stored
+     */
+    unsigned int getDistinctCount() {
+        std::lock_guard<std::mutex> lock(mutex);
+        return count;
+    }
+
+private:
+    const std::string& valueAt(unsigned int handle) const {
+        return chunks[handle >> CHUNK_BITS][handle & (CHUNK_SIZE - 1)];
+    }
+
+    /**
+     * FNV-1a - same string hash as the secondary indexes
+     */
+    static unsigned int hashString(const std::string& value) {
+        unsigned int h = 2166136261u;
+        for (char c : value) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 16777619u;
+        }
+        return h;
+    }
+
+    void rehash(unsigned int newCapacity) {
+        unsigned int* newTable = new unsigned int[newCapacity]();
+        unsigned int mask = newCapacity - 1;
+        for (unsigned int i = 0; i < capacity; i++) {
+            if (table[i] == 0) continue;
+            unsigned int index = hashString(valueAt(table[i] - 1)) & mask;
+            while (newTable[index] != 0) {
+                index = (index + 1) & mask;
+            }
+            newTable[index] = table[i];
+        }
+        delete[] table;
+        table = newTable;
+        capacity = newCapacity;
+    }
+};
+
+/**
+ * The process-wide pool shared by every interned Patient field
+ */
+inline InternPool& pool() {
+    static InternPool instance;
+    return instance;
+}
+
+}  // namespace intern
+
+#endif // INTERN_H
@@ -2,56 +2,83 @@
 #define LINKED_LIST_H
 
 #include "Patient.h"
+#include "NodePool.h"
 #include <string>
-#include <sstream>
+#include <utility>
+#include <vector>
 
 /**
- * Singly Linked List Implementation for Patient Records
+ * Doubly Linked List Implementation for Patient Records
  * ======================================================
- * 
- * WHY LINKED LIST?
- * ----------------
+ *
+ * WHY A DOUBLY LINKED LIST WITH EXPOSED NODE HANDLES?
+ * ---------------------------------------------------
  * 1. Dynamic Size: Unlike arrays, linked lists can grow/shrink at runtime
  *    without needing to know the maximum number of patients in advance.
- * 
+ *
  * 2. Efficient Insertion: O(1) time for adding new patient at head
  *    (No need to shift elements like in arrays)
- * 
- * 3. Efficient Deletion: O(1) time once the node is found
- *    (Just update pointers, no shifting required)
- * 
- * 4. No Memory Waste: Memory is allocated only for actual patients
- *    (Arrays might allocate more space than needed)
- * 
+ *
+ * 3. TRUE O(1) Deletion: addPatient returns the node handle, which
+ *    the manager stores in its hash index. A delete resolves the
+ *    ID to the node in O(1) and unlinks it in place via the 'prev'
+ *    pointer - no re-scan from the head. (The old singly linked
+ *    list found the node via the index, threw that away, and
+ *    walked the list again - milliseconds per delete deep in the
+ *    list.)
+ *
+ * 4. In-Place Update: updateNode writes the new field values
+ *    straight into the node the index handed us - O(1), and the
+ *    Patient's address never changes, so the ordered index's data
+ *    pointers stay valid.
+ *
  * TIME COMPLEXITY:
  * ----------------
- * - Insert at head: O(1)
- * - Insert at tail: O(n) - must traverse to end
- * - Delete by ID:   O(n) - must search for the ID first
- * - Search by ID:   O(n) - linear search required
- * - Display All:    O(n) - must visit each node
- * 
+ * - Insert at head:    O(1)
+ * - Unlink by handle:  O(1)
+ * - Update by handle:  O(1)
+ * - Search by ID:      O(n) - callers should use the hash index
+ * - Display All:       O(n) - must visit each node
+ *
  * SPACE COMPLEXITY:
  * -----------------
  * - O(n) where n = number of patients
- * - Each node uses extra memory for the 'next' pointer
+ * - Each node carries 'prev' and 'next' pointers
  */
 
+// List node - exposed so the hash index can hold handles to it
+// (see PatientHashMap). The Patient lives inside the node, so a
+// Patient* from '&node->data' is stable for the node's lifetime.
+class PatientNode {
+public:
+    Patient data;       // Patient information
+    PatientNode* next;  // Pointer to next node
+    PatientNode* prev;  // Pointer to previous node (enables O(1) unlink)
+
+    // Constructors (copying and moving the record in)
+    PatientNode(const Patient& p) : data(p), next(nullptr), prev(nullptr) {}
+    PatientNode(Patient&& p) : data(std::move(p)), next(nullptr), prev(nullptr) {}
+};
+
 class PatientLinkedList {
 private:
-    // Inner class for the linked list node
-    class PatientNode {
-    public:
-        Patient data;       // Patient information
-        PatientNode* next;  // Pointer to next node
-        
-        // Constructor
-        PatientNode(const Patient& p) : data(p), next(nullptr) {}
-    };
-
+    NodePool<PatientNode> nodePool;  // Slab allocator for nodes
     PatientNode* head;  // Pointer to first node
     int size;           // Track number of patients
 
+    /**
+     * Splice a freshly constructed node in at the head
+     */
+    PatientNode* linkAtHead(PatientNode* newNode) {
+        newNode->next = head;
+        if (head != nullptr) {
+            head->prev = newNode;
+        }
+        head = newNode;
+        size++;
+        return newNode;
+    }
+
 public:
     /**
      * Constructor - Initialize empty list
@@ -59,96 +86,87 @@ public:
     PatientLinkedList() : head(nullptr), size(0) {}
 
     /**
-     * Destructor - Free all allocated memory
-     * Prevents memory leaks
+     * Destructor - Run node destructors, then the pool frees all
+     * of its blocks wholesale (no per-node deallocation)
      */
     ~PatientLinkedList() {
         PatientNode* current = head;
         while (current != nullptr) {
-            PatientNode* toDelete = current;
+            PatientNode* toDestroy = current;
             current = current->next;
-            delete toDelete;
+            toDestroy->~PatientNode();
         }
     }
 
     /**
      * Add new patient to the list (at head for O(1) insertion)
-     * 
+     *
      * @param patient The patient to add
-     * @return true if successful
-     * 
+     * @return Handle to the new node - callers index it so later
+     *         unlink/update skip the list walk entirely
+     *
      * Time: O(1) | Space: O(1)
      */
-    bool addPatient(const Patient& patient) {
-        PatientNode* newNode = new PatientNode(patient);
-        newNode->next = head;
-        head = newNode;
-        size++;
-        return true;
+    PatientNode* addPatient(const Patient& patient) {
+        return linkAtHead(new (nodePool.grab()) PatientNode(patient));
     }
 
     /**
-     * Delete patient by ID
-     * 
-     * @param patientId The ID of patient to delete
-     * @return true if found and deleted, false otherwise
-     * 
-     * Time: O(n) - must search for the patient
-     * Space: O(1)
+     * Rvalue overload: moves the caller's Patient (and its string
+     * buffers) into the node instead of copying it
      */
-    bool deletePatient(int patientId) {
-        if (head == nullptr) return false;
-
-        // Special case: deleting head
-        if (head->data.getPatientId() == patientId) {
-            PatientNode* toDelete = head;
-            head = head->next;
-            delete toDelete;
-            size--;
-            return true;
-        }
+    PatientNode* addPatient(Patient&& patient) {
+        return linkAtHead(new (nodePool.grab()) PatientNode(std::move(patient)));
+    }
 
-        // Search for patient
-        PatientNode* current = head;
-        while (current->next != nullptr) {
-            if (current->next->data.getPatientId() == patientId) {
-                PatientNode* toDelete = current->next;
-                current->next = current->next->next;
-                delete toDelete;
-                size--;
-                return true;
-            }
-            current = current->next;
+    /**
+     * Unlink a node by handle (the 'prev' pointer makes this O(1) -
+     * no walk from the head to find the predecessor)
+     *
+     * @param node Handle previously returned by addPatient
+     *
+     * Time: O(1) | Space: O(1)
+     */
+    void unlink(PatientNode* node) {
+        if (node->prev != nullptr) {
+            node->prev->next = node->next;
+        } else {
+            head = node->next;
         }
-        return false;
+        if (node->next != nullptr) {
+            node->next->prev = node->prev;
+        }
+        node->~PatientNode();
+        nodePool.release(node);
+        size--;
     }
 
     /**
-     * Update patient information
-     * 
-     * @param patientId The ID of patient to update
-     * @param updatedPatient New patient data (ID remains same)
-     * @return true if found and updated, false otherwise
-     * 
-     * Time: O(n) | Space: O(1)
+     * Update a node's patient data in place by handle
+     * (ID and the Patient's address remain the same)
+     *
+     * Time: O(1) | Space: O(1)
      */
-    bool updatePatient(int patientId, const Patient& updatedPatient) {
-        PatientNode* current = head;
-        while (current != nullptr) {
-            if (current->data.getPatientId() == patientId) {
-                // Keep the same ID, update other fields
-                current->data.setName(updatedPatient.getName());
-                current->data.setAge(updatedPatient.getAge());
-                current->data.setGender(updatedPatient.getGender());
-                current->data.setDisease(updatedPatient.getDisease());
-                current->data.setContactNumber(updatedPatient.getContactNumber());
-                current->data.setAppointmentDate(updatedPatient.getAppointmentDate());
-                current->data.setVisitNotes(updatedPatient.getVisitNotes());
-                return true;
-            }
-            current = current->next;
-        }
-        return false;
+    void updateNode(PatientNode* node, const Patient& updatedPatient) {
+        node->data.setName(updatedPatient.getName());
+        node->data.setAge(updatedPatient.getAge());
+        node->data.setGender(updatedPatient.getGender());
+        node->data.setDisease(updatedPatient.getDisease());
+        node->data.setContactNumber(updatedPatient.getContactNumber());
+        node->data.setAppointmentDate(updatedPatient.getAppointmentDate());
+        node->data.setVisitNotes(updatedPatient.getVisitNotes());
+    }
+
+    /**
+     * Rvalue overload: the caller is done with its Patient, so the
+     * seven string buffers are moved into the node rather than
+     * copied (ID still preserved)
+     *
+     * Time: O(1) | Space: O(1)
+     */
+    void updateNode(PatientNode* node, Patient&& updatedPatient) {
+        updatedPatient.setPatientId(node->data.getPatientId());
+        node->data = std::move(updatedPatient);
     }
 
     /**
@@ -176,18 +194,62 @@ public:
      * Time: O(n) | Space: O(n) for output string
      */
     std::string getAllPatientsJSON() const {
-        std::stringstream ss;
-        ss << "[";
+        std::string out;
+        out.reserve(static_cast<std::size_t>(size) * 192 + 2);
+        out += "[";
         PatientNode* current = head;
         bool first = true;
         while (current != nullptr) {
-            if (!first) ss << ",";
-            ss << current->data.toJSON();
+            if (!first) out += ",";
+            current->data.appendJSON(out);
+            first = false;
+            current = current->next;
+        }
+        out += "]";
+        return out;
+    }
+
+    /**
+     * Get one page of patients as JSON array string
+     *
+     * Walks past 'offset' records and renders at most 'limit', so
+     * the cost is O(offset + limit) rather than O(n) - the first
+     * page of a huge data set is effectively free.
+     */
+    std::string getPatientsPageJSON(int offset, int limit) const {
+        std::string out;
+        out.reserve(static_cast<std::size_t>(limit > 0 ? limit : 0) * 192 + 2);
+        out += "[";
+        PatientNode* current = head;
+        for (int skipped = 0; current != nullptr && skipped < offset; skipped++) {
+            current = current->next;
+        }
+        bool first = true;
+        for (int emitted = 0; current != nullptr && emitted < limit; emitted++) {
+            if (!first) out += ",";
+            current->data.appendJSON(out);
             first = false;
             current = current->next;
         }
-        ss << "]";
-        return ss.str();
+        out += "]";
+        return out;
+    }
+
+    /**
+     * Collect pointers to every stored patient (insertion order)
+     *
+     * Lets callers walk the records without going through JSON -
+     * used by the structured-data path in the bindings.
+     *
+     * Time: O(n) | Space: O(n) for the pointer vector
+     */
+    void collectPatients(std::vector<const Patient*>& out) const {
+        out.reserve(out.size() + static_cast<std::size_t>(size));
+        PatientNode* current = head;
+        while (current != nullptr) {
+            out.push_back(&current->data);
+            current = current->next;
+        }
     }
 
     /**
@@ -0,0 +1,152 @@
+#ifndef NODE_POOL_H
+#define NODE_POOL_H
+
+#include <cstddef>
+
+/**
+ * Slab / Pool Allocator for Data Structure Nodes
+ * ===============================================
+ *
+ * WHY A NODE POOL?
+ * ----------------
+ * 1. One Allocation Per Thousands of Nodes: Every linked list and
+ *    tree node used to be its own `new`/`delete`, so a large data
+ *    set meant millions of tiny heap allocations and a badly
+ *    fragmented heap after a day of churn. The pool grabs memory
+ *    in large contiguous blocks instead.
+ *
+ * 2. Cache-Friendly Traversal: Nodes allocated back-to-back end up
+ *    physically adjacent, so walking the list or tree touches
+ *    sequential cache lines instead of jumping around the heap.
+ *
+ * 3. Fast Teardown: Destroying the structure releases whole blocks
+ *    at once - a handful of frees instead of one per node.
+ *
+ * 4. O(1) Recycling: Removed nodes go onto an internal free list
+ *    and are handed back out before any new block is carved.
+ *
+ * HOW IT WORKS:
+ * -------------
+ * - Memory comes in fixed-size blocks of BLOCK_CAPACITY slots,
+ *   chained together so they can all be freed at teardown.
+ * - grab() returns raw storage for one node: first from the free
+ *   list of recycled slots, then from the unused tail of the
+ *   newest block, allocating a fresh block only when both are dry.
+ * - The caller constructs into the slot with placement-new and,
+ *   on removal, runs the destructor and calls release().
+ *
+ * REAL-WORLD ANALOGY:
+ * -------------------
+ * A hotel doesn't build a new room for each guest - it builds a
+ * whole floor at a time and keeps a list of vacated rooms to hand
+ * out first.
+ *
+ * TIME COMPLEXITY:
+ * ----------------
+ * - grab():    O(1) (amortized - occasionally allocates a block)
+ * - release(): O(1)
+ * - Teardown:  O(blocks), not O(nodes)
+ *
+ * SPACE COMPLEXITY:
+ * -----------------
+ * - O(n) with at most one partially used block of overhead
+ */
+
+template <typename T>
+class NodePool {
+private:
+    static const std::size_t BLOCK_CAPACITY = 4096;  // Slots per block
+
+    /**
+     * One slot either holds a live node or, while recycled, a link
+     * to the next free slot (the storage is reused for the link).
+     */
+    union Slot {
+        alignas(T) unsigned char storage[sizeof(T)];
+        Slot* nextFree;
+    };
+
+    /**
+     * One contiguous block of slots, chained for wholesale teardown
+     */
+    struct Block {
+        Block* next;
+        Slot slots[BLOCK_CAPACITY];
+    };
+
+    Block* blocks;          // Newest block first
+    Slot* freeList;         // Recycled slots, ready for reuse
+    std::size_t nextUnused; // First never-used slot in newest block
+
+public:
+    /**
+     * Constructor - No memory allocated until the first grab()
+     */
+    NodePool() : blocks(nullptr), freeList(nullptr), nextUnused(BLOCK_CAPACITY) {}
+
+    /**
+     * Destructor - Free all blocks wholesale
+     * NOTE: does not run node destructors; the owning structure
+     * must destroy live nodes before the pool goes away.
+     */
+    ~NodePool() {
+        releaseAll();
+    }
+
+    // Non-copyable (owns raw memory handed out to the structure)
+    NodePool(const NodePool&) = delete;
+    NodePool& operator=(const NodePool&) = delete;
+
+    /**
+     * Get raw storage for one node (construct into it with
+     * placement-new)
+     *
+     * Time: O(1) amortized
+     */
+    void* grab() {
+        // Prefer a recycled slot
+        if (freeList != nullptr) {
+            Slot* slot = freeList;
+            freeList = slot->nextFree;
+            return slot;
+        }
+
+        // Carve from the newest block, allocating one if exhausted
+        if (nextUnused == BLOCK_CAPACITY) {
+            Block* block = new Block;
+            block->next = blocks;
+            blocks = block;
+            nextUnused = 0;
+        }
+        return &blocks->slots[nextUnused++];
+    }
+
+    /**
+     * Return a slot to the pool for reuse (caller has already run
+     * the node's destructor)
+     *
+     * Time: O(1)
+     */
+    void release(void* p) {
+        Slot* slot = static_cast<Slot*>(p);
+        slot->nextFree = freeList;
+        freeList = slot;
+    }
+
+    /**
+     * Free every block at once and reset to the empty state
+     *
+     * Time: O(blocks)
+     */
+    void releaseAll() {
+        while (blocks != nullptr) {
+            Block* toDelete = blocks;
+            blocks = blocks->next;
+            delete toDelete;
+        }
+        freeList = nullptr;
+        nextUnused = BLOCK_CAPACITY;
+    }
+};
+
+#endif // NODE_POOL_H
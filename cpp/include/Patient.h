@@ -1,8 +1,10 @@
 #ifndef PATIENT_H
 #define PATIENT_H
 
+#include "JsonUtil.h"
+#include "Intern.h"
 #include <string>
-#include <sstream>
+#include <utility>
 
 /**
  * Patient Class
@@ -17,89 +19,127 @@
  */
 class Patient {
 private:
+    // Low-cardinality fields (gender ~3 distinct values, disease a
+    // few hundred, appointmentDate ~one per clinic day) are stored
+    // as 4-byte handles into the global intern pool - see Intern.h.
+    // Millions of records share one copy of each distinct value.
+    //
+    // contactNumber stays a std::string: at <= 15 characters it
+    // fits libstdc++'s inline small-string buffer, so it never
+    // heap-allocates anyway. name and visitNotes are genuinely
+    // per-patient and stay owned strings.
     int patientId;
     std::string name;
     int age;
-    std::string gender;
-    std::string disease;
+    unsigned int genderHandle;
+    unsigned int diseaseHandle;
     std::string contactNumber;
-    std::string appointmentDate;
+    unsigned int appointmentDateHandle;
     std::string visitNotes;
 
 public:
-    // Default constructor
-    Patient() : patientId(0), age(0) {}
+    // Default constructor (handle 0 is the interned empty string)
+    Patient()
+        : patientId(0), age(0), genderHandle(0), diseaseHandle(0),
+          appointmentDateHandle(0) {}
 
-    // Parameterized constructor
-    Patient(int id, const std::string& n, int a, const std::string& g,
-            const std::string& d, const std::string& c, 
-            const std::string& appt, const std::string& notes)
-        : patientId(id), name(n), age(a), gender(g),
-          disease(d), contactNumber(c), appointmentDate(appt), visitNotes(notes) {}
+    // Parameterized constructor. Owned string parameters are taken
+    // by value and moved into place; interned fields reduce to a
+    // pool lookup.
+    Patient(int id, std::string n, int a, const std::string& g,
+            const std::string& d, std::string c,
+            const std::string& appt, std::string notes)
+        : patientId(id), name(std::move(n)), age(a),
+          genderHandle(intern::pool().intern(g)),
+          diseaseHandle(intern::pool().intern(d)),
+          contactNumber(std::move(c)),
+          appointmentDateHandle(intern::pool().intern(appt)),
+          visitNotes(std::move(notes)) {}
 
     // Getters and Setters
+    //
+    // Getters return const references - serialization and indexing
+    // read each field in place instead of allocating a temporary
+    // string per field per record. For interned fields the
+    // reference points into the pool (stable for the process
+    // lifetime); their setters intern the new value. Owned-string
+    // setters take by value and move.
     int getPatientId() const { return patientId; }
     void setPatientId(int id) { patientId = id; }
 
-    std::string getName() const { return name; }
-    void setName(const std::string& n) { name = n; }
+    const std::string& getName() const { return name; }
+    void setName(std::string n) { name = std::move(n); }
 
     int getAge() const { return age; }
     void setAge(int a) { age = a; }
 
-    std::string getGender() const { return gender; }
-    void setGender(const std::string& g) { gender = g; }
+    const std::string& getGender() const { return intern::pool().get(genderHandle); }
+    void setGender(const std::string& g) { genderHandle = intern::pool().intern(g); }
 
-    std::string getDisease() const { return disease; }
-    void setDisease(const std::string& d) { disease = d; }
+    const std::string& getDisease() const { return intern::pool().get(diseaseHandle); }
+    void setDisease(const std::string& d) { diseaseHandle = intern::pool().intern(d); }
 
-    std::string getContactNumber() const { return contactNumber; }
-    void setContactNumber(const std::string& c) { contactNumber = c; }
+    const std::string& getContactNumber() const { return contactNumber; }
+    void setContactNumber(std::string c) { contactNumber = std::move(c); }
 
-    std::string getAppointmentDate() const { return appointmentDate; }
-    void setAppointmentDate(const std::string& appt) { appointmentDate = appt; }
+    const std::string& getAppointmentDate() const {
+        return intern::pool().get(appointmentDateHandle);
+    }
+    void setAppointmentDate(const std::string& appt) {
+        appointmentDateHandle = intern::pool().intern(appt);
+    }
+
+    const std::string& getVisitNotes() const { return visitNotes; }
+    void setVisitNotes(std::string notes) { visitNotes = std::move(notes); }
 
-    std::string getVisitNotes() const { return visitNotes; }
-    void setVisitNotes(const std::string& notes) { visitNotes = notes; }
+    // Interned handles exposed directly: two fields are equal iff
+    // their handles are equal, so index/filter comparisons can be
+    // single integer compares instead of string compares
+    unsigned int getGenderHandle() const { return genderHandle; }
+    unsigned int getDiseaseHandle() const { return diseaseHandle; }
+    unsigned int getAppointmentDateHandle() const { return appointmentDateHandle; }
+
+    /**
+     * Append this patient as a JSON object to a caller-provided
+     * buffer (see JsonUtil.h - bulk-copy escaping, to_chars ints)
+     *
+     * Callers serializing many records reuse one reserved buffer
+     * instead of building a stringstream per record.
+     *
+     * Time Complexity: O(1) - fixed number of fields
+     */
+    void appendJSON(std::string& out) const {
+        out += "{\"patientId\":";
+        jsonutil::appendInt(out, patientId);
+        out += ",\"name\":\"";
+        jsonutil::appendEscaped(out, name);
+        out += "\",\"age\":";
+        jsonutil::appendInt(out, age);
+        out += ",\"gender\":\"";
+        jsonutil::appendEscaped(out, getGender());
+        out += "\",\"disease\":\"";
+        jsonutil::appendEscaped(out, getDisease());
+        out += "\",\"contactNumber\":\"";
+        jsonutil::appendEscaped(out, contactNumber);
+        out += "\",\"appointmentDate\":\"";
+        jsonutil::appendEscaped(out, getAppointmentDate());
+        out += "\",\"visitNotes\":\"";
+        jsonutil::appendEscaped(out, visitNotes);
+        out += "\"}";
+    }
 
     /**
      * Convert patient to JSON string format
      * Used for communication with Python/Frontend
-     * 
+     *
      * Time Complexity: O(1) - fixed number of fields
      * Space Complexity: O(1) - output string size is bounded
      */
     std::string toJSON() const {
-        std::stringstream ss;
-        ss << "{";
-        ss << "\"patientId\":" << patientId << ",";
-        ss << "\"name\":\"" << escapeJSON(name) << "\",";
-        ss << "\"age\":" << age << ",";
-        ss << "\"gender\":\"" << escapeJSON(gender) << "\",";
-        ss << "\"disease\":\"" << escapeJSON(disease) << "\",";
-        ss << "\"contactNumber\":\"" << escapeJSON(contactNumber) << "\",";
-        ss << "\"appointmentDate\":\"" << escapeJSON(appointmentDate) << "\",";
-        ss << "\"visitNotes\":\"" << escapeJSON(visitNotes) << "\"";
-        ss << "}";
-        return ss.str();
-    }
-
-private:
-    // Helper function to escape special characters in JSON strings
-    // Kept private as it is a utility for internal use only
-    static std::string escapeJSON(const std::string& str) {
-        std::string result;
-        for (char c : str) {
-            switch (c) {
-                case '"': result += "\\\""; break;
-                case '\\': result += "\\\\"; break;
-                case '\n': result += "\\n"; break;
-                case '\r': result += "\\r"; break;
-                case '\t': result += "\\t"; break;
-                default: result += c;
-            }
-        }
-        return result;
+        std::string out;
+        out.reserve(192);  // Typical record fits without reallocating
+        appendJSON(out);
+        return out;
     }
 };
 
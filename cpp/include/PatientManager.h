@@ -6,8 +6,23 @@
 #include "Stack.h"
 #include "Queue.h"
 #include "BST.h"
+#include "HashMap.h"
+#include "SecondaryIndex.h"
+#include "Persistence.h"
+#include "PerfStats.h"
+#include <atomic>
+#include <cctype>
+#include <algorithm>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
 #include <string>
 #include <sstream>
+#include <thread>
+#include <tuple>
+#include <utility>
+#include <vector>
 
 /**
  * Patient Manager - Main System Controller
@@ -19,14 +34,30 @@
  * DATA STRUCTURE COORDINATION:
  * ----------------------------
  * 1. LinkedList: Primary storage for patient records
- * 2. BST: Secondary index for fast search by ID
- * 3. Queue: Appointment scheduling (FIFO)
- * 4. Stack: Activity tracking (LIFO)
- * 
+ * 2. HashMap: Primary index - O(1) point lookups by ID
+ * 3. BST (AVL): Ordered index - sorted traversal by ID
+ * 4. Secondary indexes: disease/gender (hash), name/date (ordered)
+ *    so field queries cost time proportional to the result size
+ * 5. Queue: Appointment scheduling (FIFO)
+ * 6. Stack: Activity tracking (LIFO)
+ *
  * When a patient is added:
  * - Patient is stored in LinkedList
- * - Patient ID is indexed in BST (pointing to LinkedList data)
+ * - Patient ID is indexed in HashMap and BST (both pointing to
+ *   the LinkedList data)
  * - Activity is logged to Stack
+ *
+ * Point lookups (search/update/delete/exists) go through the
+ * HashMap; the BST is consulted only when sorted order is needed.
+ *
+ * CONCURRENCY:
+ * ------------
+ * A reader-writer lock (std::shared_mutex) guards the patient
+ * structures: any number of readers (search, listings, statistics)
+ * proceed in parallel, while mutations take the lock exclusively.
+ * The activity log has its own plain mutex so that read-path
+ * logging (VIEW entries) never forces readers to exclude each
+ * other. Lock order is always rwLock before activityMutex.
  * 
  * This demonstrates how multiple data structures can work together
  * in a real-world application, each serving its optimal purpose.
@@ -34,16 +65,370 @@
 class PatientManager {
 private:
     PatientLinkedList patientList;  // Primary patient storage
-    PatientBST patientIndex;        // BST index for fast search
+    PatientHashMap patientMap;      // Hash index for O(1) point lookups
+    PatientBST patientIndex;        // Ordered (AVL) index for sorted traversal
+
+    // Secondary indexes (see SecondaryIndex.h): value -> patient IDs,
+    // kept in sync by every add/update/delete
+    StringHashIndex diseaseIndex;     // Exact-match: disease
+    StringHashIndex genderIndex;      // Exact-match: gender
+    StringOrderedIndex nameIndex;     // Prefix queries: lowercased name
+    StringOrderedIndex dateIndex;     // Range queries: appointmentDate
+
+    // Age histogram in decade buckets (0-9 ... 90-99, 100+), bumped
+    // alongside the secondary indexes so dashboard reads never scan
+    // the record set
+    static const int AGE_BUCKETS = 11;
+    long long ageHistogram[AGE_BUCKETS] = {};
+
     AppointmentQueue appointmentQueue;  // Appointment scheduling
     ActivityStack activityStack;    // Recent activity tracking
     int nextId;                     // Auto-increment ID counter
 
+    // Generation-counter cache for the full-listing JSON.
+    // dataVersion is bumped on every mutation; the rendered buffer
+    // is reused until the versions diverge, so a dashboard polling
+    // an unchanged data set costs a buffer reuse, not a re-render.
+    unsigned long long dataVersion;            // Bumped on add/update/delete
+    std::string cachedAllPatients;             // Last rendered listing
+    unsigned long long cachedAllPatientsVersion;  // Version it was rendered at
+
+    // Reader-writer lock for the patient structures (see class
+    // comment); separate mutex for the activity log so VIEW logging
+    // doesn't serialize concurrent readers
+    mutable std::shared_mutex rwLock;
+    mutable std::mutex activityMutex;
+
+    // Durability (optional - see Persistence.h): once enabled, every
+    // mutation is appended to the WAL before returning, and
+    // saveSnapshot() compacts the state and truncates the log
+    persist::WriteAheadLog wal;
+    bool durabilityEnabled = false;
+    std::string snapshotPath;
+
+    // ---- Async write pipeline ----
+    // addPatient's caller-visible work is the minimal insert (list
+    // + hash map + WAL + response). The ordered index, secondary
+    // indexes, histogram and activity entry are handed to one
+    // background worker through this single-producer (the write
+    // lock serializes producers), single-consumer ring. Reads that
+    // depend on deferred state call flushPendingWrites() first, so
+    // they still see every completed add; mutations drain the ring
+    // AFTER taking the write lock (drainPendingWritesLocked) - a
+    // flush before the lock would leave a window for a racing add
+    // to queue fresh work in between.
+    struct PendingWrite {
+        int patientId;
+        const char* action;   // Static strings only
+        const char* details;
+    };
+
+    static const std::size_t PENDING_CAPACITY = 4096;
+    PendingWrite pendingRing[PENDING_CAPACITY];
+    std::atomic<std::size_t> pendingHead{0};  // Next slot to fill (producer)
+    std::atomic<std::size_t> pendingTail{0};  // Next slot to apply (worker)
+
+    std::thread indexWorker;
+    std::atomic<bool> workerStarted{false};
+    bool stopWorker = false;            // Guarded by pendingMutex
+    mutable std::mutex pendingMutex;    // CV plumbing only - never data
+    mutable std::condition_variable pendingCv;  // Wakes the worker
+    mutable std::condition_variable drainCv;    // Wakes flush waiters
+
+    /**
+     * Index one freshly added record and log its activity entry
+     * (caller holds the write lock; used by the worker and as the
+     * inline fallback when the ring is full)
+     */
+    void applyIndexWork(const PendingWrite& work) {
+        PatientNode* node = patientMap.searchNode(work.patientId);
+        if (node == nullptr) {
+            return;  // Deleted before indexing could run
+        }
+        patientIndex.insert(work.patientId, &node->data);
+        indexPatientFields(node->data);
+
+        std::lock_guard<std::mutex> actLock(activityMutex);
+        Activity activity(work.action, work.patientId, node->data.getName(),
+                          work.details);
+        activity.markUndoable();  // Inverse: delete this ID
+        activityStack.push(activity);
+    }
+
+    /**
+     * Hand one add's index/log work to the background worker.
+     * Caller holds the write lock (which is what makes this a
+     * single-producer ring). If the ring is full the work is done
+     * inline - backpressure, never unbounded memory.
+     */
+    void enqueueIndexWork(int patientId, const char* action,
+                          const char* details) {
+        if (!workerStarted.load(std::memory_order_acquire)) {
+            indexWorker = std::thread(&PatientManager::indexWorkerLoop, this);
+            workerStarted.store(true, std::memory_order_release);
+        }
+
+        std::size_t head = pendingHead.load(std::memory_order_relaxed);
+        std::size_t next = (head + 1) % PENDING_CAPACITY;
+        if (next == pendingTail.load(std::memory_order_acquire)) {
+            applyIndexWork(PendingWrite{patientId, action, details});
+            return;
+        }
+        pendingRing[head] = PendingWrite{patientId, action, details};
+        {
+            // Publish under the CV mutex so a worker between its
+            // predicate check and its sleep can't miss the wakeup
+            std::lock_guard<std::mutex> lk(pendingMutex);
+            pendingHead.store(next, std::memory_order_release);
+        }
+        pendingCv.notify_one();
+    }
+
+    /**
+     * The background worker: drain the ring in batches, applying
+     * each batch under one write-lock acquisition
+     */
+    void indexWorkerLoop() {
+        for (;;) {
+            {
+                std::unique_lock<std::mutex> lk(pendingMutex);
+                pendingCv.wait(lk, [this] {
+                    return stopWorker ||
+                           pendingTail.load(std::memory_order_relaxed) !=
+                               pendingHead.load(std::memory_order_relaxed);
+                });
+                if (stopWorker &&
+                    pendingTail.load(std::memory_order_relaxed) ==
+                        pendingHead.load(std::memory_order_relaxed)) {
+                    return;
+                }
+            }
+
+            {
+                // Tail is read AND republished under the write
+                // lock: a mutator draining inline under that lock
+                // (drainPendingWritesLocked) advances it too, and
+                // serializing both through rwLock is what
+                // guarantees each entry is applied exactly once
+                std::unique_lock<std::shared_mutex> lock(rwLock);
+                std::size_t tail = pendingTail.load(std::memory_order_relaxed);
+                std::size_t head = pendingHead.load(std::memory_order_acquire);
+                for (std::size_t i = tail; i != head;
+                     i = (i + 1) % PENDING_CAPACITY) {
+                    applyIndexWork(pendingRing[i]);
+                }
+
+                // Publish progress only after the work landed, so
+                // a flusher released here really sees indexed state
+                std::lock_guard<std::mutex> lk(pendingMutex);
+                pendingTail.store(head, std::memory_order_release);
+            }
+            drainCv.notify_all();
+        }
+    }
+
+    /**
+     * Wait until every queued add has been indexed and logged.
+     * Called (before taking the data lock) by operations that read
+     * or mutate deferred state - the ordering guarantee: a thread
+     * always sees the effects of its own earlier writes.
+     */
+    void flushPendingWrites() const {
+        if (!workerStarted.load(std::memory_order_acquire)) {
+            return;  // Nothing was ever deferred
+        }
+        std::unique_lock<std::mutex> lk(pendingMutex);
+        drainCv.wait(lk, [this] {
+            return pendingTail.load(std::memory_order_relaxed) ==
+                   pendingHead.load(std::memory_order_relaxed);
+        });
+    }
+
+    /**
+     * Drain every queued entry inline. The caller HOLDS the write
+     * lock - that is the point: producers are stalled and the
+     * worker reads/advances the tail under the same lock, so after
+     * this returns the indexes are settled and stay settled for
+     * the rest of the caller's critical section. Mutations of
+     * deferred state (delete, update, bulk load, undo) use this
+     * instead of a pre-lock flush, which would leave a window for
+     * a racing add to queue fresh work between flush and lock.
+     */
+    void drainPendingWritesLocked() {
+        std::size_t tail = pendingTail.load(std::memory_order_relaxed);
+        std::size_t head = pendingHead.load(std::memory_order_acquire);
+        if (tail == head) {
+            return;
+        }
+        for (std::size_t i = tail; i != head; i = (i + 1) % PENDING_CAPACITY) {
+            applyIndexWork(pendingRing[i]);
+        }
+        {
+            std::lock_guard<std::mutex> lk(pendingMutex);
+            pendingTail.store(head, std::memory_order_release);
+        }
+        drainCv.notify_all();
+    }
+
+    /**
+     * Lowercase a name for the case-insensitive name index
+     */
+    static std::string toLowerKey(const std::string& value) {
+        std::string key = value;
+        for (char& c : key) {
+            c = static_cast<char>(std::tolower(static_cast<unsigned char>(c)));
+        }
+        return key;
+    }
+
+    /**
+     * Which decade bucket an age falls in (clamped to [0, 100+])
+     */
+    static int ageBucketOf(int age) {
+        if (age < 0) return 0;
+        int bucket = age / 10;
+        return (bucket < AGE_BUCKETS) ? bucket : AGE_BUCKETS - 1;
+    }
+
+    /**
+     * Register a patient's field values in the secondary indexes
+     * and aggregate counters (caller holds the write lock)
+     */
+    void indexPatientFields(const Patient& patient) {
+        int patientId = patient.getPatientId();
+        diseaseIndex.add(patient.getDisease(), patientId);
+        genderIndex.add(patient.getGender(), patientId);
+        nameIndex.add(toLowerKey(patient.getName()), patientId);
+        dateIndex.add(patient.getAppointmentDate(), patientId);
+        ageHistogram[ageBucketOf(patient.getAge())]++;
+    }
+
+    /**
+     * Remove a patient's field values from the secondary indexes
+     * and aggregate counters - must run while the record still
+     * holds its old values
+     */
+    void unindexPatientFields(const Patient& patient) {
+        int patientId = patient.getPatientId();
+        diseaseIndex.remove(patient.getDisease(), patientId);
+        genderIndex.remove(patient.getGender(), patientId);
+        nameIndex.remove(toLowerKey(patient.getName()), patientId);
+        dateIndex.remove(patient.getAppointmentDate(), patientId);
+        ageHistogram[ageBucketOf(patient.getAge())]--;
+    }
+
+    /**
+     * Remove one patient from storage, all indexes and the WAL
+     * (caller holds the write lock and bumps dataVersion)
+     *
+     * @param outCopy Receives the record as it was before removal
+     *                (the undo before-image)
+     * @return true if the patient existed
+     */
+    bool removePatientLocked(int patientId, Patient& outCopy) {
+        PatientNode* node = patientMap.searchNode(patientId);
+        if (node == nullptr) {
+            return false;
+        }
+        outCopy = node->data;
+
+        // Unregister field values while the record still holds them
+        unindexPatientFields(node->data);
+        patientMap.remove(patientId);
+        patientIndex.remove(patientId);
+        patientList.unlink(node);  // O(1) - no list re-scan
+
+        if (durabilityEnabled) {
+            wal.appendDelete(patientId);
+        }
+        return true;
+    }
+
+    // Snapshot-isolated iteration: a refcounted, immutable copy of
+    // the record set. Captured under the read lock in one O(n)
+    // sweep (seconds of rendering never happen under any lock -
+    // writers stall for the copy, not the export). The shared_ptr
+    // keeps the snapshot alive for exactly as long as someone is
+    // iterating it, however many exporters share it.
+    using RecordSnapshot = std::shared_ptr<const std::vector<Patient>>;
+
+    /**
+     * Copy every live record (insertion order) under a brief
+     * shared lock
+     *
+     * @param versionOut Receives the dataVersion the snapshot
+     *                   reflects (for cache-fill checks)
+     */
+    RecordSnapshot captureSnapshot(unsigned long long* versionOut = nullptr) const {
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+        std::vector<const Patient*> live;
+        patientList.collectPatients(live);
+
+        auto snapshot = std::make_shared<std::vector<Patient>>();
+        snapshot->reserve(live.size());
+        for (const Patient* patient : live) {
+            snapshot->push_back(*patient);
+        }
+        if (versionOut != nullptr) {
+            *versionOut = dataVersion;
+        }
+        return snapshot;
+    }
+
+    /**
+     * Render the patients behind a list of IDs as the standard
+     * query envelope (caller holds at least the read lock)
+     */
+    std::string renderPatientsByIds(const std::vector<int>& ids) const {
+        std::string out;
+        out.reserve(64 + ids.size() * 192);
+        out += "{\"success\":true,\"count\":";
+        jsonutil::appendInt(out, static_cast<long long>(ids.size()));
+        out += ",\"patients\":[";
+        bool first = true;
+        for (int patientId : ids) {
+            const Patient* patient = patientMap.search(patientId);
+            if (patient == nullptr) continue;  // Should not happen
+            if (!first) out += ',';
+            patient->appendJSON(out);
+            first = false;
+        }
+        out += "]}";
+        return out;
+    }
+
 public:
+    /**
+     * One patient record for bulk loading:
+     * (patientId, name, age, gender, disease, contactNumber,
+     *  appointmentDate, visitNotes)
+     */
+    using PatientRecord = std::tuple<int, std::string, int, std::string,
+                                     std::string, std::string, std::string,
+                                     std::string>;
+
     /**
      * Constructor - Initialize system
      */
-    PatientManager() : nextId(1001) {}
+    PatientManager() : nextId(1001), dataVersion(1), cachedAllPatientsVersion(0) {}
+
+    /**
+     * Destructor - drain and stop the index worker (it finishes
+     * whatever is still queued before exiting)
+     */
+    ~PatientManager() {
+        if (workerStarted.load(std::memory_order_acquire)) {
+            {
+                std::lock_guard<std::mutex> lk(pendingMutex);
+                stopWorker = true;
+            }
+            pendingCv.notify_all();
+            indexWorker.join();
+        }
+    }
+
+    PatientManager(const PatientManager&) = delete;
+    PatientManager& operator=(const PatientManager&) = delete;
 
     // ==================== PATIENT OPERATIONS ====================
 
@@ -55,26 +440,34 @@ public:
     std::string addPatient(const std::string& name, int age, const std::string& gender,
                            const std::string& disease, const std::string& contactNumber,
                            const std::string& appointmentDate, const std::string& visitNotes) {
+        perf::ScopedTimer timer(perf::OP_ADD);
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+
         // Create patient with auto-generated ID
         int patientId = nextId++;
         Patient patient(patientId, name, age, gender, disease, 
                         contactNumber, appointmentDate, visitNotes);
         
-        // Add to linked list
-        patientList.addPatient(patient);
-        
-        // Get pointer to stored patient and add to BST
-        Patient* storedPatient = patientList.getPatientById(patientId);
-        patientIndex.insert(patientId, storedPatient);
-        
-        // Log activity
-        Activity activity("ADD", patientId, name, "New patient registered");
-        activityStack.push(activity);
-        
+        // Hot section: the minimal insert that makes the record
+        // findable (list + hash map) plus the durability append.
+        // Ordered index, secondary indexes and the activity entry
+        // are deferred to the background worker - dependent reads
+        // flush first (see flushPendingWrites)
+        PatientNode* node = patientList.addPatient(std::move(patient));
+        patientMap.insert(patientId, node);
+
+        if (durabilityEnabled) {
+            wal.appendUpsert(persist::WAL_ADD, node->data);
+        }
+
+        enqueueIndexWork(patientId, "ADD", "New patient registered");
+
+        dataVersion++;  // Invalidate listing cache
+
         // Return success response
         std::stringstream ss;
         ss << "{\"success\":true,\"message\":\"Patient added successfully\",";
-        ss << "\"patient\":" << patient.toJSON() << "}";
+        ss << "\"patient\":" << node->data.toJSON() << "}";
         return ss.str();
     }
 
@@ -86,79 +479,239 @@ public:
                                   const std::string& contactNumber,
                                   const std::string& appointmentDate, 
                                   const std::string& visitNotes) {
-        // Check if ID already exists
-        if (patientList.exists(patientId)) {
+        perf::ScopedTimer timer(perf::OP_ADD);
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+
+        // Check if ID already exists - O(1) via hash index
+        if (patientMap.contains(patientId)) {
             return "{\"success\":false,\"message\":\"Patient ID already exists\"}";
         }
-        
-        Patient patient(patientId, name, age, gender, disease, 
+
+        Patient patient(patientId, name, age, gender, disease,
                         contactNumber, appointmentDate, visitNotes);
-        
-        patientList.addPatient(patient);
-        Patient* storedPatient = patientList.getPatientById(patientId);
-        patientIndex.insert(patientId, storedPatient);
-        
-        Activity activity("ADD", patientId, name, "Patient registered");
-        activityStack.push(activity);
-        
+
+        // Same pipelined shape as addPatient above
+        PatientNode* node = patientList.addPatient(std::move(patient));
+        patientMap.insert(patientId, node);
+
+        if (durabilityEnabled) {
+            wal.appendUpsert(persist::WAL_ADD, node->data);
+        }
+
+        enqueueIndexWork(patientId, "ADD", "Patient registered");
+
         // Update nextId if needed
         if (patientId >= nextId) {
             nextId = patientId + 1;
         }
-        
+
+        dataVersion++;  // Invalidate listing cache
+
         std::stringstream ss;
         ss << "{\"success\":true,\"message\":\"Patient added successfully\",";
-        ss << "\"patient\":" << patient.toJSON() << "}";
+        ss << "\"patient\":" << node->data.toJSON() << "}";
         return ss.str();
     }
 
     /**
-     * Search patient by ID using BST (fast search)
-     * 
+     * Bulk load a batch of patient records (for restores/imports)
+     *
+     * Replaying a restore through addPatientWithId pays an existence
+     * check, a JSON response allocation and an activity push per
+     * record. This path amortizes all of that across the batch:
+     * - duplicates are skipped via the O(1) hash index
+     * - no per-record JSON responses or activity entries
+     * - the ordered index is built bottom-up from sorted input in
+     *   O(n) when it starts empty (the restore case), falling back
+     *   to O(log n) inserts when merging into existing data
+     *
+     * @return JSON summary with loaded/skipped counts
+     */
+    std::string bulkLoadPatients(const std::vector<PatientRecord>& records) {
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+        drainPendingWritesLocked();  // The index bulk-build needs a settled tree
+
+        int loaded = 0;
+        int skipped = 0;
+
+        // New (id, pointer) pairs destined for the ordered index
+        std::vector<std::pair<int, Patient*>> newEntries;
+        newEntries.reserve(records.size());
+
+        for (const PatientRecord& record : records) {
+            int patientId = std::get<0>(record);
+
+            // Dedupe via hash index - O(1) per record
+            if (patientMap.contains(patientId)) {
+                skipped++;
+                continue;
+            }
+
+            Patient patient(patientId, std::get<1>(record), std::get<2>(record),
+                            std::get<3>(record), std::get<4>(record),
+                            std::get<5>(record), std::get<6>(record),
+                            std::get<7>(record));
+
+            PatientNode* node = patientList.addPatient(std::move(patient));
+            patientMap.insert(patientId, node);
+            indexPatientFields(node->data);
+            newEntries.emplace_back(patientId, &node->data);
+
+            if (durabilityEnabled) {
+                wal.appendUpsert(persist::WAL_ADD, node->data);
+            }
+
+            if (patientId >= nextId) {
+                nextId = patientId + 1;
+            }
+            loaded++;
+        }
+
+        // Build the ordered index in one pass when possible
+        std::sort(newEntries.begin(), newEntries.end());
+        if (patientIndex.isEmpty()) {
+            patientIndex.buildFromSorted(newEntries);
+        } else {
+            for (const auto& entry : newEntries) {
+                patientIndex.insert(entry.first, entry.second);
+            }
+        }
+
+        if (loaded > 0) {
+            dataVersion++;  // Invalidate listing cache
+        }
+
+        // One summary activity instead of one per record
+        if (loaded > 0) {
+            std::lock_guard<std::mutex> actLock(activityMutex);
+            Activity activity("LOAD", 0, "System",
+                              "Bulk load completed");
+            activityStack.push(activity);
+        }
+
+        std::stringstream ss;
+        ss << "{\"success\":true,\"loaded\":" << loaded << ",";
+        ss << "\"skipped\":" << skipped << ",";
+        ss << "\"totalPatients\":" << patientList.getSize() << "}";
+        return ss.str();
+    }
+
+    /**
+     * Search patient by ID using hash index (fast search)
+     *
+     * @param logView Record a VIEW audit entry for this lookup.
+     *                Pass false on hot polling paths to keep the
+     *                read truly read-only.
+     *
      * @return JSON response with patient data or error
      */
-    std::string searchPatient(int patientId) {
-        // Use BST for O(log n) search
-        Patient* patient = patientIndex.search(patientId);
-        
+    std::string searchPatient(int patientId, bool logView = true) {
+        perf::ScopedTimer timer(perf::OP_SEARCH);
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+
+        // Use hash map for O(1) search
+        Patient* patient = patientMap.search(patientId);
+
         if (patient == nullptr) {
             return "{\"success\":false,\"message\":\"Patient not found\"}";
         }
-        
-        // Log activity
-        Activity activity("VIEW", patientId, patient->getName(), "Patient record viewed");
-        activityStack.push(activity);
+
+        // Log activity (own mutex - doesn't exclude other readers)
+        if (logView) {
+            std::lock_guard<std::mutex> actLock(activityMutex);
+            Activity activity("VIEW", patientId, patient->getName(),
+                              "Patient record viewed");
+            activityStack.push(activity);
+        }
         
         std::stringstream ss;
         ss << "{\"success\":true,\"patient\":" << patient->toJSON() << "}";
         return ss.str();
     }
 
+    /**
+     * Direct lookup without response formatting or activity logging
+     *
+     * NOTE: returns a pointer into live storage and takes no lock -
+     * only safe when the caller guarantees no concurrent writers.
+     * Concurrent callers should use getPatientCopy instead.
+     *
+     * @return Pointer to the stored patient, or nullptr
+     */
+    const Patient* findPatient(int patientId) const {
+        return patientMap.search(patientId);
+    }
+
+    /**
+     * Thread-safe point lookup that copies the record out under the
+     * read lock - backs the structured-data path in the bindings
+     *
+     * @return true and fills 'out' if found, false otherwise
+     */
+    bool getPatientCopy(int patientId, Patient& out) const {
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+        const Patient* patient = patientMap.search(patientId);
+        if (patient == nullptr) {
+            return false;
+        }
+        out = *patient;
+        return true;
+    }
+
+    /**
+     * Collect pointers to every stored patient (insertion order)
+     *
+     * NOTE: unsynchronized, like findPatient - the pointers are only
+     * valid while no writer runs. Concurrent callers should use
+     * getAllPatientsCopy.
+     */
+    std::vector<const Patient*> getAllPatientPointers() const {
+        std::vector<const Patient*> out;
+        patientList.collectPatients(out);
+        return out;
+    }
+
+    /**
+     * Thread-safe full snapshot: copies every record out under the
+     * read lock - structured-data counterpart of getAllPatients
+     */
+    std::vector<Patient> getAllPatientsCopy() const {
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+        std::vector<const Patient*> pointers;
+        patientList.collectPatients(pointers);
+        std::vector<Patient> out;
+        out.reserve(pointers.size());
+        for (const Patient* patient : pointers) {
+            out.push_back(*patient);
+        }
+        return out;
+    }
+
     /**
      * Delete patient from system
      * 
      * @return JSON response with success status
      */
     std::string deletePatient(int patientId) {
-        // First check if patient exists
-        Patient* patient = patientIndex.search(patientId);
-        
-        if (patient == nullptr) {
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+        drainPendingWritesLocked();  // Unindexing assumes the record was indexed
+
+        Patient removed;
+        if (!removePatientLocked(patientId, removed)) {
             return "{\"success\":false,\"message\":\"Patient not found\"}";
         }
-        
-        std::string patientName = patient->getName();
-        
-        // Remove from BST first
-        patientIndex.remove(patientId);
-        
-        // Remove from linked list
-        patientList.deletePatient(patientId);
-        
+
         // Log activity
-        Activity activity("DELETE", patientId, patientName, "Patient record deleted");
-        activityStack.push(activity);
-        
+        {
+            std::lock_guard<std::mutex> actLock(activityMutex);
+            Activity activity("DELETE", patientId, removed.getName(),
+                              "Patient record deleted");
+            activity.attachBeforeImage(removed);  // Inverse: re-add it
+            activityStack.push(activity);
+        }
+
+        dataVersion++;  // Invalidate listing cache
+
         return "{\"success\":true,\"message\":\"Patient deleted successfully\"}";
     }
 
@@ -172,28 +725,48 @@ public:
                                const std::string& contactNumber,
                                const std::string& appointmentDate, 
                                const std::string& visitNotes) {
-        // Check if patient exists
-        Patient* existingPatient = patientIndex.search(patientId);
-        
-        if (existingPatient == nullptr) {
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+        drainPendingWritesLocked();  // Re-keying assumes the record was indexed
+
+        // Check if patient exists - O(1) via hash index
+        PatientNode* node = patientMap.searchNode(patientId);
+
+        if (node == nullptr) {
             return "{\"success\":false,\"message\":\"Patient not found\"}";
         }
-        
+
         // Create updated patient data
-        Patient updatedPatient(patientId, name, age, gender, disease, 
+        Patient updatedPatient(patientId, name, age, gender, disease,
                                contactNumber, appointmentDate, visitNotes);
-        
-        // Update in linked list
-        patientList.updatePatient(patientId, updatedPatient);
-        
-        // Get updated pointer (same memory location, values updated)
-        Patient* updated = patientList.getPatientById(patientId);
-        patientIndex.updatePatientPointer(patientId, updated);
+
+        // Snapshot the record before it changes (the undo image)
+        Patient before = node->data;
+
+        // Re-key the secondary indexes: out under the old values,
+        // back in under the new ones
+        unindexPatientFields(node->data);
+
+        // Update in place by handle - O(1), and the Patient's
+        // address doesn't change, so the ID indexes stay valid.
+        // updatedPatient is done with: its string buffers move in.
+        patientList.updateNode(node, std::move(updatedPatient));
+        Patient* updated = &node->data;
+        indexPatientFields(*updated);
+
+        if (durabilityEnabled) {
+            wal.appendUpsert(persist::WAL_UPDATE, *updated);
+        }
         
         // Log activity
-        Activity activity("UPDATE", patientId, name, "Patient record updated");
-        activityStack.push(activity);
-        
+        {
+            std::lock_guard<std::mutex> actLock(activityMutex);
+            Activity activity("UPDATE", patientId, name, "Patient record updated");
+            activity.attachBeforeImage(before);  // Inverse: restore it
+            activityStack.push(activity);
+        }
+
+        dataVersion++;  // Invalidate listing cache
+
         std::stringstream ss;
         ss << "{\"success\":true,\"message\":\"Patient updated successfully\",";
         ss << "\"patient\":" << updated->toJSON() << "}";
@@ -202,47 +775,664 @@ public:
 
     /**
      * Get all patients (from linked list)
+     *
+     * Served from the generation-counter cache: the listing is
+     * re-rendered only when a mutation has happened since the last
+     * call.
      */
     std::string getAllPatients() {
-        return patientList.getAllPatientsJSON();
+        perf::ScopedTimer timer(perf::OP_LIST_ALL);
+        // Fast path: cache is fresh, share the lock with other readers
+        {
+            std::shared_lock<std::shared_mutex> lock(rwLock);
+            if (cachedAllPatientsVersion == dataVersion) {
+                return cachedAllPatients;
+            }
+        }
+
+        // Slow path: render from a snapshot so the (possibly long)
+        // serialization holds no lock at all - writers stall only
+        // for the O(n) record copy inside captureSnapshot
+        unsigned long long snapshotVersion = 0;
+        RecordSnapshot snapshot = captureSnapshot(&snapshotVersion);
+
+        std::string listing;
+        listing.reserve(snapshot->size() * 192 + 2);
+        listing += "[";
+        bool first = true;
+        for (const Patient& patient : *snapshot) {
+            if (!first) listing += ",";
+            patient.appendJSON(listing);
+            first = false;
+        }
+        listing += "]";
+
+        // Install in the cache only if no write landed while we
+        // rendered (a stale fill would serve old data as fresh)
+        {
+            std::unique_lock<std::shared_mutex> lock(rwLock);
+            if (snapshotVersion == dataVersion &&
+                cachedAllPatientsVersion != dataVersion) {
+                cachedAllPatients = listing;
+                cachedAllPatientsVersion = snapshotVersion;
+            }
+        }
+        return listing;
+    }
+
+    /**
+     * Render the full patient set as a JSON array across worker
+     * threads (the nightly-export path)
+     *
+     * Serialization is embarrassingly parallel: the record set is
+     * split into contiguous shards, each worker renders its shard
+     * into a private buffer (no shared state, no false sharing),
+     * and the shards are concatenated once at the end. A 2.4M-row
+     * export that took seconds single-threaded scales with cores
+     * until memory bandwidth wins.
+     *
+     * The workers iterate a snapshot (see captureSnapshot), so no
+     * lock is held while rendering: writers stall only for the
+     * record copy, and the export sees one consistent version no
+     * matter how many mutations land mid-render.
+     *
+     * @param threadCount Worker threads; 0 = hardware concurrency.
+     *                    Small data sets render inline - forking
+     *                    threads costs more than they'd save.
+     */
+    std::string exportPatientsJSON(int threadCount = 0) {
+        RecordSnapshot snapshot = captureSnapshot();
+        const std::vector<Patient>& records = *snapshot;
+        const std::size_t total = records.size();
+
+        std::size_t workers = threadCount > 0
+            ? static_cast<std::size_t>(threadCount)
+            : static_cast<std::size_t>(
+                  std::max(1u, std::thread::hardware_concurrency()));
+
+        // Keep every shard worth a thread's startup cost
+        static const std::size_t MIN_SHARD = 8192;
+        if (workers > 1 && total / workers < MIN_SHARD) {
+            workers = std::max<std::size_t>(1, total / MIN_SHARD);
+        }
+
+        std::vector<std::string> shards(workers);
+        const std::size_t perShard = workers ? (total + workers - 1) / workers : 0;
+
+        auto renderShard = [&records, &shards, perShard, total](std::size_t s) {
+            std::size_t begin = s * perShard;
+            std::size_t end = std::min(begin + perShard, total);
+            std::string& out = shards[s];
+            out.reserve((end - begin) * 192);
+            for (std::size_t i = begin; i < end; i++) {
+                if (i > begin) out += ",";
+                records[i].appendJSON(out);
+            }
+        };
+
+        if (workers <= 1) {
+            if (workers == 1) renderShard(0);
+        } else {
+            std::vector<std::thread> pool;
+            pool.reserve(workers - 1);
+            for (std::size_t s = 1; s < workers; s++) {
+                pool.emplace_back(renderShard, s);
+            }
+            renderShard(0);  // This thread takes the first shard
+            for (std::thread& t : pool) {
+                t.join();
+            }
+        }
+
+        // One final concatenation at memory-copy speed
+        std::size_t bytes = 2 + workers;
+        for (const std::string& shard : shards) bytes += shard.size();
+        std::string out;
+        out.reserve(bytes);
+        out += "[";
+        bool first = true;
+        for (const std::string& shard : shards) {
+            if (shard.empty()) continue;
+            if (!first) out += ",";
+            out += shard;
+            first = false;
+        }
+        out += "]";
+        return out;
+    }
+
+    /**
+     * Current data version (bumped on every add/update/delete) -
+     * lets callers do their own change detection
+     */
+    unsigned long long getDataVersion() const {
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+        return dataVersion;
+    }
+
+    /**
+     * Get one page of patients (insertion order)
+     *
+     * @param offset Records to skip from the front of the list
+     * @param limit  Maximum records to return
+     */
+    std::string getPatients(int offset, int limit) {
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+
+        std::stringstream ss;
+        ss << "{\"success\":true,\"offset\":" << offset << ",";
+        ss << "\"limit\":" << limit << ",";
+        ss << "\"total\":" << patientList.getSize() << ",";
+        ss << "\"patients\":" << patientList.getPatientsPageJSON(offset, limit) << "}";
+        return ss.str();
     }
 
     /**
      * Get all patients sorted by ID (using BST in-order traversal)
      */
     std::string getPatientsSortedById() {
+        flushPendingWrites();
+        std::shared_lock<std::shared_mutex> lock(rwLock);
         return patientIndex.getSortedPatientsJSON();
     }
 
+    /**
+     * Get one page of patients in ID order, starting after a given
+     * ID (keyset pagination - O(log n + limit) per page)
+     *
+     * The response carries "lastId" so the caller passes it back as
+     * afterId to fetch the next page; "hasMore" is false once the
+     * page came back short.
+     */
+    std::string getPatientsSortedById(int afterId, int limit) {
+        flushPendingWrites();
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+
+        int count = 0;
+        int lastId = afterId;
+        std::string page =
+            patientIndex.getSortedPatientsAfterJSON(afterId, limit, count, lastId);
+
+        std::stringstream ss;
+        ss << "{\"success\":true,\"count\":" << count << ",";
+        ss << "\"lastId\":" << lastId << ",";
+        ss << "\"hasMore\":" << ((count == limit) ? "true" : "false") << ",";
+        ss << "\"patients\":" << page << "}";
+        return ss.str();
+    }
+
+    /**
+     * Patients with IDs in [loId, hiId), in ascending order, with
+     * the same keyset-paginated shape as getPatientsSortedById -
+     * pass the response's lastId back as afterId for the next page
+     *
+     * Walks only the relevant subtrees: O(log n + page) however
+     * many records exist outside the range. The billing-job path -
+     * previously a full dump filtered in Python.
+     */
+    std::string getPatientsInIdRange(int loId, int hiId, int afterId = 0,
+                                     int limit = 1000) {
+        flushPendingWrites();
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+
+        int count = 0;
+        int lastId = afterId;
+        std::string page =
+            patientIndex.searchRangeJSON(loId, hiId, afterId, limit, count, lastId);
+
+        std::stringstream ss;
+        ss << "{\"success\":true,\"loId\":" << loId << ",";
+        ss << "\"hiId\":" << hiId << ",";
+        ss << "\"count\":" << count << ",";
+        ss << "\"lastId\":" << lastId << ",";
+        ss << "\"hasMore\":" << ((count == limit) ? "true" : "false") << ",";
+        ss << "\"patients\":" << page << "}";
+        return ss.str();
+    }
+
+    /**
+     * Patients with an appointment date in [from, to] (inclusive,
+     * ISO date strings compare lexicographically), in date order,
+     * as one offset/limit page
+     *
+     * Served from the appointmentDate secondary index: the AVL
+     * walk touches only the keys inside the window, so cost is
+     * O(log n + matches), not a scan of the record set.
+     */
+    std::string getAppointmentsInWindow(const std::string& from,
+                                        const std::string& to,
+                                        int offset = 0, int limit = 1000) {
+        flushPendingWrites();
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+
+        std::vector<int> ids;
+        dateIndex.collectRange(from, to, ids);
+
+        std::size_t begin = static_cast<std::size_t>(offset > 0 ? offset : 0);
+        if (begin > ids.size()) begin = ids.size();
+        std::size_t end = begin + static_cast<std::size_t>(limit > 0 ? limit : 0);
+        if (end > ids.size()) end = ids.size();
+
+        std::string out;
+        out.reserve(128 + (end - begin) * 192);
+        out += "{\"success\":true,\"total\":";
+        jsonutil::appendInt(out, static_cast<long long>(ids.size()));
+        out += ",\"offset\":";
+        jsonutil::appendInt(out, offset);
+        out += ",\"count\":";
+        jsonutil::appendInt(out, static_cast<long long>(end - begin));
+        out += ",\"hasMore\":";
+        out += (end < ids.size()) ? "true" : "false";
+        out += ",\"patients\":[";
+        bool first = true;
+        for (std::size_t i = begin; i < end; i++) {
+            const Patient* patient = patientMap.search(ids[i]);
+            if (patient == nullptr) continue;  // Should not happen
+            if (!first) out += ',';
+            patient->appendJSON(out);
+            first = false;
+        }
+        out += "]}";
+        return out;
+    }
+
+    /**
+     * Raw chunk of ID-ordered patients for the streaming iterator
+     * in the bindings (plain JSON array, no envelope)
+     */
+    std::string getSortedChunkJSON(int afterId, int limit, int& count, int& lastId) {
+        flushPendingWrites();
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+        return patientIndex.getSortedPatientsAfterJSON(afterId, limit, count, lastId);
+    }
+
+    // ==================== BATCH OPERATIONS ====================
+    // One call, one lock acquisition, one response buffer - instead
+    // of paying the binding crossing and lock per record
+
+    /**
+     * Look up many patients in one call
+     *
+     * @return JSON with the found records plus the IDs that matched
+     *         nothing (no VIEW activity entries - this is a bulk
+     *         render path)
+     */
+    std::string searchPatients(const std::vector<int>& patientIds) {
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+
+        std::string out;
+        out.reserve(64 + patientIds.size() * 192);
+        out += "{\"success\":true,\"patients\":[";
+        std::vector<int> missing;
+        bool first = true;
+        for (int patientId : patientIds) {
+            const Patient* patient = patientMap.search(patientId);
+            if (patient == nullptr) {
+                missing.push_back(patientId);
+                continue;
+            }
+            if (!first) out += ',';
+            patient->appendJSON(out);
+            first = false;
+        }
+        out += "],\"found\":";
+        jsonutil::appendInt(out,
+                            static_cast<long long>(patientIds.size() - missing.size()));
+        out += ",\"missing\":[";
+        for (std::size_t i = 0; i < missing.size(); i++) {
+            if (i > 0) out += ',';
+            jsonutil::appendInt(out, missing[i]);
+        }
+        out += "]}";
+        return out;
+    }
+
+    /**
+     * Delete many patients in one call (one lock, one cache
+     * invalidation, one summary activity entry)
+     */
+    std::string deletePatients(const std::vector<int>& patientIds) {
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+        drainPendingWritesLocked();  // Unindexing assumes the records were indexed
+
+        int deleted = 0;
+        int notFound = 0;
+        Patient removed;
+        for (int patientId : patientIds) {
+            if (removePatientLocked(patientId, removed)) {
+                deleted++;
+            } else {
+                notFound++;
+            }
+        }
+
+        if (deleted > 0) {
+            dataVersion++;  // Invalidate listing cache (once)
+            std::lock_guard<std::mutex> actLock(activityMutex);
+            Activity activity("DELETE", 0, "System", "Batch delete completed");
+            activityStack.push(activity);
+        }
+
+        std::stringstream ss;
+        ss << "{\"success\":true,\"deleted\":" << deleted << ",";
+        ss << "\"notFound\":" << notFound << ",";
+        ss << "\"totalPatients\":" << patientList.getSize() << "}";
+        return ss.str();
+    }
+
+    /**
+     * Queue many patients in one call (all at the default priority;
+     * unknown or already-queued IDs are skipped and reported)
+     */
+    std::string addToQueueBatch(const std::vector<int>& patientIds) {
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+
+        int queued = 0;
+        std::vector<int> skipped;
+        for (int patientId : patientIds) {
+            Patient* patient = patientMap.search(patientId);
+            if (patient == nullptr || appointmentQueue.isInQueue(patientId)) {
+                skipped.push_back(patientId);
+                continue;
+            }
+            Appointment appt(patientId, patient->getName(),
+                             patient->getAppointmentDate());
+            appointmentQueue.enqueue(appt);
+            queued++;
+        }
+
+        if (queued > 0) {
+            std::lock_guard<std::mutex> actLock(activityMutex);
+            Activity activity("QUEUE", 0, "System", "Batch enqueue completed");
+            activityStack.push(activity);
+        }
+
+        std::string out;
+        out.reserve(64 + skipped.size() * 8);
+        out += "{\"success\":true,\"queued\":";
+        jsonutil::appendInt(out, queued);
+        out += ",\"skipped\":[";
+        for (std::size_t i = 0; i < skipped.size(); i++) {
+            if (i > 0) out += ',';
+            jsonutil::appendInt(out, skipped[i]);
+        }
+        out += "],\"queueSize\":";
+        jsonutil::appendInt(out, appointmentQueue.getSize());
+        out += "}";
+        return out;
+    }
+
+    /**
+     * Process up to maxCount appointments in one call (service
+     * order: most urgent first, FIFO within a priority)
+     */
+    std::string processAppointments(int maxCount) {
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+
+        std::string out;
+        out.reserve(64 + static_cast<std::size_t>(maxCount > 0 ? maxCount : 0) * 180);
+        out += "{\"success\":true,\"processed\":[";
+        int processed = 0;
+        while (processed < maxCount && !appointmentQueue.isEmpty()) {
+            Appointment appt = appointmentQueue.dequeue();
+            if (processed > 0) out += ',';
+            appt.appendJSON(out);
+            processed++;
+        }
+        out += "],\"count\":";
+        jsonutil::appendInt(out, processed);
+        out += ",\"remainingInQueue\":";
+        jsonutil::appendInt(out, appointmentQueue.getSize());
+        out += "}";
+
+        if (processed > 0) {
+            std::lock_guard<std::mutex> actLock(activityMutex);
+            Activity activity("PROCESS", 0, "System", "Batch processing completed");
+            activityStack.push(activity);
+        }
+        return out;
+    }
+
+    // ==================== FIELD QUERIES ====================
+
+    /**
+     * Find all patients with a given disease (exact match, via the
+     * disease hash index)
+     *
+     * Time: O(1) + O(matches) - no full scan
+     */
+    std::string searchByDisease(const std::string& disease) {
+        flushPendingWrites();
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+        std::vector<int> ids;
+        diseaseIndex.collect(disease, ids);
+        return renderPatientsByIds(ids);
+    }
+
+    /**
+     * Find all patients of a given gender (exact match, via the
+     * gender hash index)
+     */
+    std::string searchByGender(const std::string& gender) {
+        flushPendingWrites();
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+        std::vector<int> ids;
+        genderIndex.collect(gender, ids);
+        return renderPatientsByIds(ids);
+    }
+
+    /**
+     * Find all patients whose name starts with the given prefix
+     * (case-insensitive, via the ordered name index)
+     *
+     * Time: O(log n) + O(matches)
+     */
+    std::string searchByName(const std::string& prefix) {
+        flushPendingWrites();
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+        std::vector<int> ids;
+        nameIndex.collectPrefix(toLowerKey(prefix), ids);
+        return renderPatientsByIds(ids);
+    }
+
+    // ==================== DURABILITY ====================
+
+    /**
+     * Enable the durability subsystem (see Persistence.h)
+     *
+     * Recovers state from <dir>/snapshot.bin plus the WAL tail in
+     * <dir>/wal.bin, then keeps the WAL open so every subsequent
+     * mutation is logged before its call returns. The snapshot is
+     * bulk-loaded (one sequential read, balanced index built
+     * bottom-up), so cold start is O(n) with no per-record response
+     * or activity overhead.
+     *
+     * @return JSON summary of what was recovered
+     */
+    std::string enableDurability(const std::string& dir) {
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+        drainPendingWritesLocked();  // Replay re-keys/unindexes records
+
+        snapshotPath = dir + "/snapshot.bin";
+        std::string walPath = dir + "/wal.bin";
+
+        // 1. Load the snapshot image (if present) and bulk-load it
+        std::vector<Patient> snapshotRecords;
+        int savedNextId = nextId;
+        bool hadSnapshot =
+            persist::SnapshotFile::load(snapshotPath, snapshotRecords, savedNextId);
+
+        int recovered = 0;
+        std::vector<std::pair<int, Patient*>> newEntries;
+        newEntries.reserve(snapshotRecords.size());
+        for (const Patient& record : snapshotRecords) {
+            int patientId = record.getPatientId();
+            if (patientMap.contains(patientId)) continue;
+            PatientNode* node = patientList.addPatient(record);
+            patientMap.insert(patientId, node);
+            indexPatientFields(node->data);
+            newEntries.emplace_back(patientId, &node->data);
+            if (patientId >= nextId) nextId = patientId + 1;
+            recovered++;
+        }
+        std::sort(newEntries.begin(), newEntries.end());
+        if (patientIndex.isEmpty()) {
+            patientIndex.buildFromSorted(newEntries);
+        } else {
+            for (const auto& entry : newEntries) {
+                patientIndex.insert(entry.first, entry.second);
+            }
+        }
+        if (hadSnapshot && savedNextId > nextId) {
+            nextId = savedNextId;
+        }
+
+        // 2. Replay the WAL tail on top of the snapshot
+        int replayed = persist::WriteAheadLog::replay(
+            walPath,
+            [this](persist::WalOp op, const Patient& patient) {
+                int patientId = patient.getPatientId();
+                PatientNode* existing = patientMap.searchNode(patientId);
+                if (op == persist::WAL_ADD && existing == nullptr) {
+                    PatientNode* node = patientList.addPatient(patient);
+                    patientMap.insert(patientId, node);
+                    patientIndex.insert(patientId, &node->data);
+                    indexPatientFields(node->data);
+                    if (patientId >= nextId) nextId = patientId + 1;
+                } else if (op == persist::WAL_UPDATE && existing != nullptr) {
+                    unindexPatientFields(existing->data);
+                    patientList.updateNode(existing, patient);
+                    indexPatientFields(existing->data);
+                }
+            },
+            [this](int patientId) {
+                PatientNode* existing = patientMap.searchNode(patientId);
+                if (existing != nullptr) {
+                    unindexPatientFields(existing->data);
+                    patientMap.remove(patientId);
+                    patientIndex.remove(patientId);
+                    patientList.unlink(existing);
+                }
+            });
+
+        // 3. Keep the WAL open for appending from here on
+        bool walOpen = wal.open(walPath);
+        durabilityEnabled = walOpen;
+        dataVersion++;
+
+        std::stringstream ss;
+        ss << "{\"success\":" << (walOpen ? "true" : "false") << ",";
+        ss << "\"snapshotLoaded\":" << (hadSnapshot ? "true" : "false") << ",";
+        ss << "\"recoveredPatients\":" << recovered << ",";
+        ss << "\"walOpsReplayed\":" << replayed << ",";
+        ss << "\"totalPatients\":" << patientList.getSize() << "}";
+        return ss.str();
+    }
+
+    /**
+     * Write a compact snapshot of the full state and truncate the
+     * WAL (crash-safe: written to a temp file, then renamed)
+     */
+    std::string saveSnapshot() {
+        flushPendingWrites();
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+
+        if (!durabilityEnabled) {
+            return "{\"success\":false,\"message\":\"Durability not enabled\"}";
+        }
+
+        std::vector<const Patient*> patients;
+        patientList.collectPatients(patients);
+        bool saved = persist::SnapshotFile::save(snapshotPath, patients, nextId);
+        if (saved) {
+            wal.reset();  // Snapshot captures everything logged so far
+        }
+
+        std::stringstream ss;
+        ss << "{\"success\":" << (saved ? "true" : "false") << ",";
+        ss << "\"patientsSaved\":" << patients.size() << "}";
+        return ss.str();
+    }
+
     // ==================== QUEUE OPERATIONS ====================
 
     /**
      * Add patient to appointment queue
+     *
+     * @param priority Triage urgency (lower = served sooner); the
+     *                 default keeps plain FIFO behavior
      */
-    std::string addToQueue(int patientId) {
-        // Check if patient exists
-        Patient* patient = patientIndex.search(patientId);
-        
+    std::string addToQueue(int patientId,
+                           int priority = AppointmentQueue::DEFAULT_PRIORITY) {
+        perf::ScopedTimer timer(perf::OP_QUEUE);
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+
+        // Check if patient exists - O(1) via hash index
+        Patient* patient = patientMap.search(patientId);
+
         if (patient == nullptr) {
             return "{\"success\":false,\"message\":\"Patient not found\"}";
         }
-        
+
         // Check if already in queue
         if (appointmentQueue.isInQueue(patientId)) {
             return "{\"success\":false,\"message\":\"Patient already in queue\"}";
         }
-        
+
         // Add to queue
         Appointment appt(patientId, patient->getName(), patient->getAppointmentDate());
-        appointmentQueue.enqueue(appt);
-        
+        appointmentQueue.enqueueWithPriority(appt, priority);
+
         // Log activity
-        Activity activity("QUEUE", patientId, patient->getName(), "Added to appointment queue");
-        activityStack.push(activity);
-        
+        {
+            std::lock_guard<std::mutex> actLock(activityMutex);
+            Activity activity("QUEUE", patientId, patient->getName(),
+                              "Added to appointment queue");
+            activityStack.push(activity);
+        }
+
         std::stringstream ss;
         ss << "{\"success\":true,\"message\":\"Patient added to queue\",";
-        ss << "\"position\":" << appointmentQueue.getSize() << ",";
+        ss << "\"priority\":" << priority << ",";
+        ss << "\"position\":" << appointmentQueue.getPosition(patientId) << ",";
+        ss << "\"queueSize\":" << appointmentQueue.getSize() << "}";
+        return ss.str();
+    }
+
+    /**
+     * Re-triage a waiting patient (lower priority value = served
+     * sooner); the queue re-sifts them in O(log n)
+     */
+    std::string changeQueuePriority(int patientId, int newPriority) {
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+
+        if (!appointmentQueue.changePriority(patientId, newPriority)) {
+            return "{\"success\":false,\"message\":\"Patient not in queue\"}";
+        }
+
+        std::stringstream ss;
+        ss << "{\"success\":true,\"message\":\"Priority updated\",";
+        ss << "\"priority\":" << newPriority << ",";
+        ss << "\"position\":" << appointmentQueue.getPosition(patientId) << "}";
+        return ss.str();
+    }
+
+    /**
+     * Where a patient stands in the queue (1 = served next) -
+     * answers the portal's "you are #N" without serializing the
+     * whole waiting list
+     */
+    std::string getQueuePosition(int patientId) {
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+
+        int position = appointmentQueue.getPositionOf(patientId);
+        if (position < 0) {
+            return "{\"success\":false,\"message\":\"Patient not in queue\"}";
+        }
+
+        std::stringstream ss;
+        ss << "{\"success\":true,\"patientId\":" << patientId << ",";
+        ss << "\"position\":" << position << ",";
         ss << "\"queueSize\":" << appointmentQueue.getSize() << "}";
         return ss.str();
     }
@@ -251,6 +1441,9 @@ public:
      * Process next appointment (dequeue)
      */
     std::string processNextAppointment() {
+        perf::ScopedTimer timer(perf::OP_QUEUE);
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+
         if (appointmentQueue.isEmpty()) {
             return "{\"success\":false,\"message\":\"No appointments in queue\"}";
         }
@@ -258,9 +1451,12 @@ public:
         Appointment appt = appointmentQueue.dequeue();
         
         // Log activity
-        Activity activity("PROCESS", appt.getPatientId(), appt.getPatientName(), 
-                          "Appointment processed");
-        activityStack.push(activity);
+        {
+            std::lock_guard<std::mutex> actLock(activityMutex);
+            Activity activity("PROCESS", appt.getPatientId(), appt.getPatientName(),
+                              "Appointment processed");
+            activityStack.push(activity);
+        }
         
         std::stringstream ss;
         ss << "{\"success\":true,\"message\":\"Appointment processed\",";
@@ -273,6 +1469,8 @@ public:
      * Get waiting list
      */
     std::string getWaitingList() {
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+
         std::stringstream ss;
         ss << "{\"success\":true,\"queueSize\":" << appointmentQueue.getSize() << ",";
         ss << "\"waitingList\":" << appointmentQueue.getWaitingListJSON() << "}";
@@ -283,6 +1481,8 @@ public:
      * Peek at next appointment without processing
      */
     std::string peekNextAppointment() {
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+
         if (appointmentQueue.isEmpty()) {
             return "{\"success\":false,\"message\":\"No appointments in queue\"}";
         }
@@ -299,6 +1499,9 @@ public:
      * Get recent activities
      */
     std::string getRecentActivities(int count = 10) {
+        flushPendingWrites();  // Deferred ADD entries belong in the view
+        std::lock_guard<std::mutex> actLock(activityMutex);
+
         std::stringstream ss;
         ss << "{\"success\":true,\"count\":" << activityStack.getSize() << ",";
         ss << "\"activities\":" << activityStack.getRecentActivitiesJSON(count) << "}";
@@ -309,6 +1512,9 @@ public:
      * Get all activities
      */
     std::string getAllActivities() {
+        flushPendingWrites();  // Deferred ADD entries belong in the view
+        std::lock_guard<std::mutex> actLock(activityMutex);
+
         std::stringstream ss;
         ss << "{\"success\":true,\"count\":" << activityStack.getSize() << ",";
         ss << "\"activities\":" << activityStack.getAllActivitiesJSON() << "}";
@@ -319,6 +1525,9 @@ public:
      * Pop last activity (for undo feature)
      */
     std::string popLastActivity() {
+        flushPendingWrites();
+        std::lock_guard<std::mutex> actLock(activityMutex);
+
         if (activityStack.isEmpty()) {
             return "{\"success\":false,\"message\":\"No activities to undo\"}";
         }
@@ -329,22 +1538,214 @@ public:
         return ss.str();
     }
 
+    /**
+     * Undo the most recent reversible operation in one call
+     *
+     * Walks the activity ring backwards for the newest ADD, UPDATE
+     * or DELETE that hasn't been undone, then reverses it natively:
+     * ADD is undone by deleting the record, UPDATE by restoring the
+     * before-image the activity carries, DELETE by re-inserting it -
+     * each with full index/aggregate maintenance and WAL logging,
+     * like any other mutation. The entry stays in the audit trail,
+     * marked undone. Undo depth is bounded by the ring capacity.
+     */
+    std::string undoLastOperation() {
+        std::unique_lock<std::shared_mutex> lock(rwLock);
+        // Drain BEFORE taking activityMutex - applying an entry
+        // pushes its activity record under that same mutex
+        drainPendingWritesLocked();  // The newest add must be undoable too
+        std::lock_guard<std::mutex> actLock(activityMutex);
+
+        Activity* target = activityStack.latestUndoable();
+        if (target == nullptr) {
+            return "{\"success\":false,\"message\":\"Nothing to undo\"}";
+        }
+
+        int patientId = target->getPatientId();
+        std::string action = target->getAction();
+        std::string patientName = target->getPatientName();
+        bool reversed = false;
+
+        if (action == "ADD") {
+            // Inverse: remove the record the ADD created
+            Patient removed;
+            reversed = removePatientLocked(patientId, removed);
+        } else if (action == "UPDATE") {
+            // Inverse: put the before-image back
+            PatientNode* node = patientMap.searchNode(patientId);
+            if (node != nullptr) {
+                const Patient& image = target->getBeforeImage();
+                unindexPatientFields(node->data);
+                patientList.updateNode(node, image);
+                indexPatientFields(node->data);
+                if (durabilityEnabled) {
+                    wal.appendUpsert(persist::WAL_UPDATE, node->data);
+                }
+                reversed = true;
+            }
+        } else if (action == "DELETE") {
+            // Inverse: re-insert the before-image
+            if (!patientMap.contains(patientId)) {
+                const Patient& image = target->getBeforeImage();
+                PatientNode* node = patientList.addPatient(image);
+                patientMap.insert(patientId, node);
+                patientIndex.insert(patientId, &node->data);
+                indexPatientFields(node->data);
+                if (durabilityEnabled) {
+                    wal.appendUpsert(persist::WAL_ADD, node->data);
+                }
+                if (patientId >= nextId) {
+                    nextId = patientId + 1;
+                }
+                reversed = true;
+            }
+        }
+
+        // Consume the entry either way - if the record has since
+        // changed shape (e.g. deleted through another path), retrying
+        // the same undo forever would never succeed
+        target->markUndone();
+
+        if (!reversed) {
+            return "{\"success\":false,"
+                   "\"message\":\"Operation can no longer be undone\"}";
+        }
+
+        dataVersion++;  // Invalidate listing cache
+        Activity entry("UNDO", patientId, patientName, "Reversed " + action);
+        activityStack.push(entry);
+
+        std::stringstream ss;
+        ss << "{\"success\":true,\"undoneAction\":\"" << action << "\",";
+        ss << "\"patientId\":" << patientId << ",";
+        ss << "\"totalPatients\":" << patientList.getSize() << "}";
+        return ss.str();
+    }
+
     // ==================== STATISTICS ====================
 
+    /**
+     * Dashboard aggregates, read straight off incrementally
+     * maintained structures - no record scan, no Python groupby:
+     * - disease and gender frequencies from the secondary indexes
+     *   (each entry already knows how many IDs it holds)
+     * - appointments-per-day from the ordered date index, which
+     *   yields the histogram already sorted by date
+     * - the decade age histogram from counters bumped on every
+     *   add/update/delete
+     *
+     * Time: O(distinct values), independent of patient count
+     */
+    std::string getAggregates() {
+        flushPendingWrites();  // Counters are maintained by the worker
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+
+        std::string out;
+        out.reserve(512);
+        out += "{\"success\":true,\"totalPatients\":";
+        jsonutil::appendInt(out, patientList.getSize());
+
+        out += ",\"diseases\":{";
+        bool first = true;
+        diseaseIndex.forEachEntry([&](const std::string& key, long long count) {
+            if (!first) out += ',';
+            out += '"';
+            jsonutil::appendEscaped(out, key);
+            out += "\":";
+            jsonutil::appendInt(out, count);
+            first = false;
+        });
+
+        out += "},\"genders\":{";
+        first = true;
+        genderIndex.forEachEntry([&](const std::string& key, long long count) {
+            if (!first) out += ',';
+            out += '"';
+            jsonutil::appendEscaped(out, key);
+            out += "\":";
+            jsonutil::appendInt(out, count);
+            first = false;
+        });
+
+        out += "},\"ageHistogram\":{";
+        for (int bucket = 0; bucket < AGE_BUCKETS; bucket++) {
+            if (bucket > 0) out += ',';
+            out += '"';
+            jsonutil::appendInt(out, bucket * 10);
+            if (bucket < AGE_BUCKETS - 1) {
+                out += '-';
+                jsonutil::appendInt(out, bucket * 10 + 9);
+            } else {
+                out += '+';
+            }
+            out += "\":";
+            jsonutil::appendInt(out, ageHistogram[bucket]);
+        }
+
+        out += "},\"appointmentDates\":{";
+        first = true;
+        dateIndex.forEachKeyInOrder([&](const std::string& key, long long count) {
+            if (!first) out += ',';
+            out += '"';
+            jsonutil::appendEscaped(out, key);
+            out += "\":";
+            jsonutil::appendInt(out, count);
+            first = false;
+        });
+        out += "}}";
+        return out;
+    }
+
+    /**
+     * Native counters (no JSON) - cross-shard fan-out sums these
+     * without parsing per-shard responses
+     */
+    int getPatientCount() const {
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+        return patientList.getSize();
+    }
+
+    int getQueueSize() const {
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+        return appointmentQueue.getSize();
+    }
+
     /**
      * Get system statistics
      */
     std::string getStatistics() {
+        flushPendingWrites();
+        std::shared_lock<std::shared_mutex> lock(rwLock);
+        int activityCount;
+        {
+            std::lock_guard<std::mutex> actLock(activityMutex);
+            activityCount = activityStack.getSize();
+        }
+
         std::stringstream ss;
         ss << "{";
         ss << "\"totalPatients\":" << patientList.getSize() << ",";
         ss << "\"queueSize\":" << appointmentQueue.getSize() << ",";
-        ss << "\"activityCount\":" << activityStack.getSize() << ",";
+        ss << "\"activityCount\":" << activityCount << ",";
         ss << "\"bstHeight\":" << patientIndex.getHeight() << ",";
-        ss << "\"nextPatientId\":" << nextId;
+        ss << "\"nextPatientId\":" << nextId << ",";
+        ss << "\"perf\":" << perf::statsJSON();
         ss << "}";
         return ss.str();
     }
+
+    /**
+     * Hot-path latency stats on their own (the always-on
+     * instrumentation in PerfStats.h): per-operation count, avg,
+     * p50/p99 (log-bucket upper bounds) and exact max, in ns.
+     *
+     * No data lock taken - the scrape reads the per-thread
+     * histogram slabs, so it can't stall (or be stalled by) the
+     * operations it measures.
+     */
+    std::string getPerfStats() const {
+        return "{\"success\":true,\"perf\":" + perf::statsJSON() + "}";
+    }
 };
 
 #endif // PATIENT_MANAGER_H
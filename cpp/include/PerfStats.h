@@ -0,0 +1,269 @@
+#ifndef PERF_STATS_H
+#define PERF_STATS_H
+
+#include "JsonUtil.h"
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+/**
+ * Hot-Path Instrumentation (always on)
+ * ====================================
+ *
+ * WHY BUILT-IN INSTRUMENTATION?
+ * -----------------------------
+ * When the portal slows down, the question is always "which layer?"
+ * - the C++ structures, serialization, or the Python boundary.
+ * These counters answer it from production itself, no profiler
+ * attach needed.
+ *
+ * WHY IT'S CHEAP ENOUGH TO LEAVE ON:
+ * ----------------------------------
+ * 1. Per-Thread Slabs: Each thread records into its OWN histogram
+ *    (registered once per thread under a mutex, then never shared
+ *    for writing). No locks and no cache-line ping-pong on the
+ *    hot path - just relaxed atomic adds to thread-private memory.
+ *
+ * 2. Log-Bucketed Histograms: A latency sample is reduced to its
+ *    power-of-two bucket (the bit width of the nanosecond count),
+ *    so recording is a clock read, a count-leading-zeros, and one
+ *    increment. 40 buckets cover 1ns..~18 minutes.
+ *
+ * 3. Two Clock Reads Per Op: steady_clock on Linux is a vDSO call
+ *    (~20ns) - noise next to the operations being timed.
+ *
+ * READING THE NUMBERS:
+ * --------------------
+ * Aggregation walks every thread's slab and sums buckets (relaxed
+ * reads - a scrape may be a few samples stale, which is fine for
+ * metrics). p50/p99 are resolved to the upper bound of the bucket
+ * the percentile falls in - bucket b spans [2^b, 2^(b+1)) ns, so
+ * the reported value is 2^(b+1)-1; max is tracked exactly.
+ */
+
+namespace perf {
+
+// The instrumented operations (indexes into the per-thread slab)
+enum Op {
+    OP_SEARCH = 0,   // searchPatient
+    OP_ADD,          // addPatient / addPatientWithId
+    OP_LIST_ALL,     // getAllPatients
+    OP_QUEUE,        // addToQueue / processNextAppointment
+    OP_COUNT
+};
+
+inline const char* opName(int op) {
+    switch (op) {
+        case OP_SEARCH:   return "searchPatient";
+        case OP_ADD:      return "addPatient";
+        case OP_LIST_ALL: return "getAllPatients";
+        case OP_QUEUE:    return "queueOps";
+        default:          return "unknown";
+    }
+}
+
+static const int BUCKETS = 40;  // Bucket b holds samples in [2^b, 2^(b+1)) ns
+
+/**
+ * One operation's histogram within one thread's slab.
+ * Atomics with relaxed ordering: the only writer is the owning
+ * thread; readers (the stats scrape) tolerate staleness.
+ */
+struct OpHistogram {
+    std::atomic<unsigned long long> buckets[BUCKETS];
+    std::atomic<unsigned long long> count;
+    std::atomic<unsigned long long> totalNs;
+    std::atomic<unsigned long long> maxNs;
+
+    OpHistogram() : count(0), totalNs(0), maxNs(0) {
+        for (int i = 0; i < BUCKETS; i++) buckets[i].store(0);
+    }
+};
+
+/**
+ * A thread's private set of histograms. Allocated on the thread's
+ * first sample, registered globally, and kept for the lifetime of
+ * the process so totals survive thread exit.
+ */
+struct ThreadSlab {
+    OpHistogram ops[OP_COUNT];
+};
+
+/**
+ * Registry of every thread's slab. The mutex guards registration
+ * only - recording never touches it.
+ */
+class Registry {
+public:
+    static Registry& instance() {
+        static Registry registry;
+        return registry;
+    }
+
+    ThreadSlab* registerThread() {
+        std::unique_ptr<ThreadSlab> slab(new ThreadSlab());
+        ThreadSlab* raw = slab.get();
+        std::lock_guard<std::mutex> lock(mutex);
+        slabs.push_back(std::move(slab));
+        return raw;
+    }
+
+    /**
+     * Sum every thread's histogram for one op (relaxed reads)
+     */
+    void aggregate(int op, unsigned long long outBuckets[BUCKETS],
+                   unsigned long long& outCount,
+                   unsigned long long& outTotalNs,
+                   unsigned long long& outMaxNs) const {
+        for (int i = 0; i < BUCKETS; i++) outBuckets[i] = 0;
+        outCount = 0;
+        outTotalNs = 0;
+        outMaxNs = 0;
+
+        std::lock_guard<std::mutex> lock(mutex);
+        for (const std::unique_ptr<ThreadSlab>& slab : slabs) {
+            const OpHistogram& h = slab->ops[op];
+            for (int i = 0; i < BUCKETS; i++) {
+                outBuckets[i] += h.buckets[i].load(std::memory_order_relaxed);
+            }
+            outCount += h.count.load(std::memory_order_relaxed);
+            outTotalNs += h.totalNs.load(std::memory_order_relaxed);
+            unsigned long long m = h.maxNs.load(std::memory_order_relaxed);
+            if (m > outMaxNs) outMaxNs = m;
+        }
+    }
+
+private:
+    Registry() {}
+    mutable std::mutex mutex;
+    // Slabs outlive their threads (totals persist after a worker
+    // exits) and are released with the registry at process exit
+    std::vector<std::unique_ptr<ThreadSlab>> slabs;
+};
+
+/**
+ * This thread's slab (allocated and registered on first use)
+ */
+inline ThreadSlab& localSlab() {
+    thread_local ThreadSlab* slab = Registry::instance().registerThread();
+    return *slab;
+}
+
+/**
+ * Record one latency sample - the entire hot-path cost of the
+ * instrumentation besides the two clock reads
+ */
+inline void record(Op op, unsigned long long ns) {
+    // Bucket = bit width of the sample (0ns -> bucket 0)
+    int bucket = 0;
+    unsigned long long v = ns;
+    while (v > 1 && bucket < BUCKETS - 1) {
+        v >>= 1;
+        bucket++;
+    }
+
+    OpHistogram& h = localSlab().ops[op];
+    h.buckets[bucket].fetch_add(1, std::memory_order_relaxed);
+    h.count.fetch_add(1, std::memory_order_relaxed);
+    h.totalNs.fetch_add(ns, std::memory_order_relaxed);
+    // Only this thread writes its slab, so a read-check-store race
+    // with itself is impossible
+    if (ns > h.maxNs.load(std::memory_order_relaxed)) {
+        h.maxNs.store(ns, std::memory_order_relaxed);
+    }
+}
+
+/**
+ * Times a scope and records it on destruction - drop one at the
+ * top of an instrumented method
+ */
+class ScopedTimer {
+public:
+    explicit ScopedTimer(Op op)
+        : op(op), start(std::chrono::steady_clock::now()) {}
+
+    ~ScopedTimer() {
+        std::chrono::steady_clock::time_point stop =
+            std::chrono::steady_clock::now();
+        record(op, static_cast<unsigned long long>(
+                       std::chrono::duration_cast<std::chrono::nanoseconds>(
+                           stop - start)
+                           .count()));
+    }
+
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+    Op op;
+    std::chrono::steady_clock::time_point start;
+};
+
+/**
+ * Resolve a percentile to the upper bound of its bucket. record()
+ * puts a sample in bucket floor(log2(ns)), so bucket i spans
+ * [2^i, 2^(i+1)) and its upper bound is 2^(i+1)-1. Log buckets
+ * trade precision for recording speed, so p50=4095ns means "at
+ * most ~4.1us" - the right granularity for spotting a regression,
+ * not for nanosecond accounting.
+ */
+inline unsigned long long percentileNs(
+    const unsigned long long buckets[BUCKETS], unsigned long long count,
+    double percentile) {
+    if (count == 0) return 0;
+    unsigned long long rank = static_cast<unsigned long long>(
+        percentile * static_cast<double>(count));
+    if (rank >= count) rank = count - 1;
+
+    unsigned long long seen = 0;
+    for (int i = 0; i < BUCKETS; i++) {
+        seen += buckets[i];
+        if (seen > rank) {
+            return (2ull << i) - 1;  // Bucket upper bound
+        }
+    }
+    return (2ull << (BUCKETS - 1)) - 1;
+}
+
+/**
+ * Render every op's stats as one JSON object:
+ * {"searchPatient":{"count":..,"avgNs":..,"p50Ns":..,"p99Ns":..,
+ *  "maxNs":..}, ...}
+ */
+inline std::string statsJSON() {
+    std::string out;
+    out.reserve(512);
+    out += "{";
+    for (int op = 0; op < OP_COUNT; op++) {
+        unsigned long long buckets[BUCKETS];
+        unsigned long long count, totalNs, maxNs;
+        Registry::instance().aggregate(op, buckets, count, totalNs, maxNs);
+
+        if (op > 0) out += ",";
+        out += "\"";
+        out += opName(op);
+        out += "\":{\"count\":";
+        jsonutil::appendInt(out, static_cast<long long>(count));
+        out += ",\"avgNs\":";
+        jsonutil::appendInt(
+            out, static_cast<long long>(count ? totalNs / count : 0));
+        out += ",\"p50Ns\":";
+        jsonutil::appendInt(
+            out, static_cast<long long>(percentileNs(buckets, count, 0.50)));
+        out += ",\"p99Ns\":";
+        jsonutil::appendInt(
+            out, static_cast<long long>(percentileNs(buckets, count, 0.99)));
+        out += ",\"maxNs\":";
+        jsonutil::appendInt(out, static_cast<long long>(maxNs));
+        out += "}";
+    }
+    out += "}";
+    return out;
+}
+
+}  // namespace perf
+
+#endif // PERF_STATS_H
@@ -0,0 +1,305 @@
+#ifndef PERSISTENCE_H
+#define PERSISTENCE_H
+
+#include "Patient.h"
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+ * Durability Subsystem: Write-Ahead Log + Binary Snapshots
+ * =========================================================
+ *
+ * WHY A WAL + SNAPSHOT PAIR?
+ * --------------------------
+ * 1. Crash Safety: All patient state lives in process memory; a
+ *    crash used to lose everything since the last manual JSON dump.
+ *    With a write-ahead log, every add/update/delete is appended to
+ *    disk before the call returns, so recovery replays at most the
+ *    operations since the last snapshot.
+ *
+ * 2. Fast Cold Start: Startup used to replay a JSON file one record
+ *    at a time through the normal add path. A snapshot is a compact
+ *    fixed-layout binary image that is read back in one sequential
+ *    pass and bulk-loaded; only the WAL tail (operations since the
+ *    snapshot) is replayed record by record.
+ *
+ * 3. Bounded Log Growth: Taking a snapshot captures the full state
+ *    and truncates the WAL, so the log never grows without bound.
+ *
+ * FILE FORMATS (native-endian, fixed layout):
+ * -------------------------------------------
+ * Snapshot: [magic u32] [version u32] [nextId u32] [count u32]
+ *           then 'count' patient records
+ * WAL:      a sequence of records, each
+ *           [op u8] + (ADD/UPDATE: full patient record,
+ *                      DELETE: patientId u32)
+ * Patient record: [patientId u32] [age u32] then the six string
+ *           fields, each [length u32][bytes]
+ *
+ * A torn final WAL record (crash mid-append) is detected by running
+ * off the end of the buffer and is simply ignored.
+ *
+ * RECOVERY SEQUENCE:
+ * ------------------
+ * 1. Read the snapshot (if present) and bulk-load its records
+ * 2. Replay the WAL tail on top of it
+ * 3. Reopen the WAL for appending
+ */
+
+namespace persist {
+
+const std::uint32_t SNAPSHOT_MAGIC = 0x31534D50u;  // "PMS1"
+const std::uint32_t FORMAT_VERSION = 1;
+
+/**
+ * Operation tags for WAL records
+ */
+enum WalOp : std::uint8_t {
+    WAL_ADD = 1,
+    WAL_UPDATE = 2,
+    WAL_DELETE = 3
+};
+
+// ---------------- low-level append/read helpers ----------------
+
+inline void appendU32(std::string& out, std::uint32_t value) {
+    char buf[4];
+    std::memcpy(buf, &value, 4);
+    out.append(buf, 4);
+}
+
+inline void appendString(std::string& out, const std::string& str) {
+    appendU32(out, static_cast<std::uint32_t>(str.size()));
+    out.append(str);
+}
+
+inline bool readU32(const std::string& data, std::size_t& offset,
+                    std::uint32_t& value) {
+    if (offset + 4 > data.size()) return false;
+    std::memcpy(&value, data.data() + offset, 4);
+    offset += 4;
+    return true;
+}
+
+inline bool readString(const std::string& data, std::size_t& offset,
+                       std::string& value) {
+    std::uint32_t length = 0;
+    if (!readU32(data, offset, length)) return false;
+    if (offset + length > data.size()) return false;
+    value.assign(data.data() + offset, length);
+    offset += length;
+    return true;
+}
+
+/**
+ * Append one patient in the fixed binary record layout
+ */
+inline void appendPatient(std::string& out, const Patient& patient) {
+    appendU32(out, static_cast<std::uint32_t>(patient.getPatientId()));
+    appendU32(out, static_cast<std::uint32_t>(patient.getAge()));
+    appendString(out, patient.getName());
+    appendString(out, patient.getGender());
+    appendString(out, patient.getDisease());
+    appendString(out, patient.getContactNumber());
+    appendString(out, patient.getAppointmentDate());
+    appendString(out, patient.getVisitNotes());
+}
+
+/**
+ * Read one patient record; returns false on a truncated buffer
+ * (leaves 'offset' wherever it stopped)
+ */
+inline bool readPatient(const std::string& data, std::size_t& offset,
+                        Patient& out) {
+    std::uint32_t id = 0, age = 0;
+    std::string name, gender, disease, contact, date, notes;
+    if (!readU32(data, offset, id)) return false;
+    if (!readU32(data, offset, age)) return false;
+    if (!readString(data, offset, name)) return false;
+    if (!readString(data, offset, gender)) return false;
+    if (!readString(data, offset, disease)) return false;
+    if (!readString(data, offset, contact)) return false;
+    if (!readString(data, offset, date)) return false;
+    if (!readString(data, offset, notes)) return false;
+    out = Patient(static_cast<int>(id), name, static_cast<int>(age),
+                  gender, disease, contact, date, notes);
+    return true;
+}
+
+/**
+ * Read a whole file into one buffer (single sequential pass)
+ */
+inline bool readFile(const std::string& path, std::string& out) {
+    std::ifstream in(path, std::ios::binary | std::ios::ate);
+    if (!in.is_open()) return false;
+    std::streamsize size = in.tellg();
+    in.seekg(0, std::ios::beg);
+    out.resize(static_cast<std::size_t>(size));
+    return static_cast<bool>(in.read(&out[0], size));
+}
+
+// ------------------------- WAL -------------------------
+
+/**
+ * Append-only binary log of mutations.
+ *
+ * Each mutation is buffered into one contiguous record and written
+ * with a single write+flush, so a crash can tear at most the final
+ * record (which replay detects and drops).
+ */
+class WriteAheadLog {
+private:
+    std::ofstream out;
+    std::string path;
+
+public:
+    /**
+     * Open (or create) the log for appending
+     */
+    bool open(const std::string& logPath) {
+        path = logPath;
+        out.open(path, std::ios::binary | std::ios::app);
+        return out.is_open();
+    }
+
+    bool isOpen() const {
+        return out.is_open();
+    }
+
+    /**
+     * Append an ADD or UPDATE record
+     */
+    void appendUpsert(WalOp op, const Patient& patient) {
+        std::string record;
+        record.reserve(256);
+        record.push_back(static_cast<char>(op));
+        appendPatient(record, patient);
+        out.write(record.data(), static_cast<std::streamsize>(record.size()));
+        out.flush();
+    }
+
+    /**
+     * Append a DELETE record
+     */
+    void appendDelete(int patientId) {
+        std::string record;
+        record.push_back(static_cast<char>(WAL_DELETE));
+        appendU32(record, static_cast<std::uint32_t>(patientId));
+        out.write(record.data(), static_cast<std::streamsize>(record.size()));
+        out.flush();
+    }
+
+    /**
+     * Truncate the log (after a snapshot has captured full state)
+     */
+    void reset() {
+        out.close();
+        out.open(path, std::ios::binary | std::ios::trunc);
+    }
+
+    /**
+     * Replay a log file, invoking the callbacks per record.
+     * Stops cleanly at a torn final record.
+     *
+     * @return Number of operations replayed
+     */
+    static int replay(const std::string& logPath,
+                      const std::function<void(WalOp, const Patient&)>& onUpsert,
+                      const std::function<void(int)>& onDelete) {
+        std::string data;
+        if (!readFile(logPath, data)) return 0;
+
+        int replayed = 0;
+        std::size_t offset = 0;
+        while (offset < data.size()) {
+            std::uint8_t op = static_cast<std::uint8_t>(data[offset]);
+            offset += 1;
+
+            if (op == WAL_ADD || op == WAL_UPDATE) {
+                Patient patient;
+                if (!readPatient(data, offset, patient)) break;  // Torn tail
+                onUpsert(static_cast<WalOp>(op), patient);
+            } else if (op == WAL_DELETE) {
+                std::uint32_t id = 0;
+                if (!readU32(data, offset, id)) break;  // Torn tail
+                onDelete(static_cast<int>(id));
+            } else {
+                break;  // Corrupt record - stop replaying
+            }
+            replayed++;
+        }
+        return replayed;
+    }
+};
+
+// ----------------------- Snapshot -----------------------
+
+/**
+ * Compact binary image of the full patient set.
+ *
+ * Written to a temporary file and renamed into place, so a crash
+ * mid-save never corrupts the previous snapshot.
+ */
+class SnapshotFile {
+public:
+    /**
+     * Save all patients plus the ID counter
+     */
+    static bool save(const std::string& path,
+                     const std::vector<const Patient*>& patients,
+                     int nextId) {
+        std::string image;
+        image.reserve(patients.size() * 256 + 16);
+        appendU32(image, SNAPSHOT_MAGIC);
+        appendU32(image, FORMAT_VERSION);
+        appendU32(image, static_cast<std::uint32_t>(nextId));
+        appendU32(image, static_cast<std::uint32_t>(patients.size()));
+        for (const Patient* patient : patients) {
+            appendPatient(image, *patient);
+        }
+
+        std::string tmpPath = path + ".tmp";
+        {
+            std::ofstream out(tmpPath, std::ios::binary | std::ios::trunc);
+            if (!out.is_open()) return false;
+            out.write(image.data(), static_cast<std::streamsize>(image.size()));
+            if (!out.good()) return false;
+        }
+        return std::rename(tmpPath.c_str(), path.c_str()) == 0;
+    }
+
+    /**
+     * Load a snapshot; returns false if absent or malformed
+     */
+    static bool load(const std::string& path,
+                     std::vector<Patient>& outPatients,
+                     int& outNextId) {
+        std::string data;
+        if (!readFile(path, data)) return false;
+
+        std::size_t offset = 0;
+        std::uint32_t magic = 0, version = 0, nextId = 0, count = 0;
+        if (!readU32(data, offset, magic) || magic != SNAPSHOT_MAGIC) return false;
+        if (!readU32(data, offset, version) || version != FORMAT_VERSION) return false;
+        if (!readU32(data, offset, nextId)) return false;
+        if (!readU32(data, offset, count)) return false;
+
+        outPatients.reserve(count);
+        for (std::uint32_t i = 0; i < count; i++) {
+            Patient patient;
+            if (!readPatient(data, offset, patient)) return false;
+            outPatients.push_back(patient);
+        }
+        outNextId = static_cast<int>(nextId);
+        return true;
+    }
+};
+
+} // namespace persist
+
+#endif // PERSISTENCE_H
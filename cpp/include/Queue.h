@@ -1,45 +1,62 @@
 #ifndef QUEUE_H
 #define QUEUE_H
 
+#include "JsonUtil.h"
+#include "HashMap.h"  // IntHashSet for O(1) membership
+#include <algorithm>
 #include <string>
-#include <sstream>
+#include <utility>
+#include <vector>
 #include <ctime>
 
 /**
- * Queue Implementation for Appointment Scheduling
- * ================================================
- * 
- * WHY QUEUE (FIFO - First In, First Out)?
- * ---------------------------------------
- * 1. Fairness: Patients who arrive first get served first
- *    This is the fundamental principle of appointment systems
- * 
- * 2. Sequential Processing: Doctors process patients in order
- *    of their arrival - no skipping or prioritization (basic version)
- * 
- * 3. Waiting Room Model: Real hospital waiting rooms work on FIFO
- *    The first patient to register is the first to be called
- * 
- * 4. Predictable Wait Times: Patients can estimate their wait
- *    based on their position in queue
- * 
+ * Priority Queue Implementation for Appointment Scheduling
+ * =========================================================
+ *
+ * WHY A BINARY HEAP WITH FIFO TIEBREAK?
+ * -------------------------------------
+ * 1. Triage: Real clinics are not strict FIFO - an emergency case
+ *    must be served before routine visits. The queue is keyed on
+ *    (priority, arrival sequence), so more urgent patients come
+ *    out first.
+ *
+ * 2. Fairness Within a Priority: Among patients with the same
+ *    priority, the arrival sequence breaks the tie - so a queue
+ *    used without priorities behaves exactly like the old FIFO
+ *    queue.
+ *
+ * 3. O(log n) Scheduling: Enqueue, dequeue and priority changes
+ *    are heap operations - no O(n^2) dequeue-and-re-enqueue
+ *    shuffle to move one patient forward.
+ *
  * REAL-WORLD ANALOGY:
  * -------------------
- * Think of a line at a ticket counter - the person who arrives 
- * first gets served first, and new people join at the back.
- * 
+ * An emergency room: everyone takes a number on arrival, but the
+ * triage nurse assigns an urgency level, and the most urgent
+ * number is called first. Equal urgency -> first come, first
+ * served.
+ *
+ * PRIORITY CONVENTION:
+ * --------------------
+ * Lower value = more urgent (1 = emergency). Plain enqueue uses
+ * DEFAULT_PRIORITY, so FIFO order holds until someone is triaged.
+ *
  * TIME COMPLEXITY:
  * ----------------
- * - Enqueue:      O(1) - add to rear
- * - Dequeue:      O(1) - remove from front
- * - Peek/Front:   O(1) - view front element
- * - Display All:  O(n) - show waiting list
- * 
+ * - Enqueue:         O(log n) - sift up
+ * - Dequeue:         O(log n) - sift down
+ * - Change Priority: O(n) find + O(log n) re-sift
+ * - Peek/Front:      O(1)     - heap root
+ * - Display All:     O(n log n) - sorted copy in service order
+ *
  * SPACE COMPLEXITY:
  * -----------------
- * - O(n) where n = number of patients in queue
+ * - O(n) where n = number of patients in queue (flat array)
  */
 
+// Default urgency for plain (untriaged) enqueues; lower = more urgent
+const int DEFAULT_APPOINTMENT_PRIORITY = 5;
+
 // Appointment class (Refactored from struct)
 class Appointment {
 public: // Keeping members public or adding getters/setters. Public for easier access inside Queue for now.
@@ -48,40 +65,60 @@ private:
     int patientId;
     std::string patientName;
     std::string appointmentTime;  // Scheduled time
-    std::string registrationTime; // When they joined queue
+    long long registrationTime;   // When they joined queue (epoch seconds)
+    int priority;                 // Urgency (lower = served sooner)
     int position;                 // Position in queue
 
 public:
-    Appointment() : patientId(0), position(0) {}
-
-    Appointment(int id, const std::string& name, const std::string& apptTime)
-        : patientId(id), patientName(name), appointmentTime(apptTime), position(0) {
-        // Record registration time
-        time_t now = time(nullptr);
-        char buf[80];
-        strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", localtime(&now));
-        registrationTime = std::string(buf);
+    Appointment()
+        : patientId(0), registrationTime(0),
+          priority(DEFAULT_APPOINTMENT_PRIORITY), position(0) {}
+
+    Appointment(int id, std::string name, std::string apptTime)
+        : patientId(id), patientName(std::move(name)),
+          appointmentTime(std::move(apptTime)),
+          registrationTime(static_cast<long long>(time(nullptr))),
+          priority(DEFAULT_APPOINTMENT_PRIORITY), position(0) {
+        // Just a clock read - rendering happens in appendJSON with a
+        // per-second cache
     }
-    
-    // Getters and Setters
+
+    // Getters and Setters (string getters return const references -
+    // no temporary per field when serializing the waiting list)
     int getPatientId() const { return patientId; }
-    std::string getPatientName() const { return patientName; }
-    std::string getAppointmentTime() const { return appointmentTime; }
-    std::string getRegistrationTime() const { return registrationTime; }
+    const std::string& getPatientName() const { return patientName; }
+    const std::string& getAppointmentTime() const { return appointmentTime; }
+    long long getRegistrationTime() const { return registrationTime; }
+    int getPriority() const { return priority; }
     int getPosition() const { return position; }
-    
+
+    void setPriority(int p) { priority = p; }
     void setPosition(int p) { position = p; }
 
+    /**
+     * Append as a JSON object into a caller-provided buffer
+     */
+    void appendJSON(std::string& out) const {
+        out += "{\"patientId\":";
+        jsonutil::appendInt(out, patientId);
+        out += ",\"patientName\":\"";
+        jsonutil::appendEscaped(out, patientName);
+        out += "\",\"appointmentTime\":\"";
+        jsonutil::appendEscaped(out, appointmentTime);
+        out += "\",\"registrationTime\":\"";
+        jsonutil::appendTimestamp(out, registrationTime);
+        out += "\",\"priority\":";
+        jsonutil::appendInt(out, priority);
+        out += ",\"position\":";
+        jsonutil::appendInt(out, position);
+        out += "}";
+    }
+
     std::string toJSON() const {
-        std::stringstream ss;
-        ss << "{";
-        ss << "\"patientId\":" << patientId << ",";
-        ss << "\"patientName\":\"" << patientName << "\",";
-        ss << "\"appointmentTime\":\"" << appointmentTime << "\",";
-        ss << "\"registrationTime\":\"" << registrationTime << "\",";
-        ss << "\"position\":" << position;
-        ss << "}";
-        return ss.str();
+        std::string out;
+        out.reserve(160);
+        appendJSON(out);
+        return out;
     }
     
     // Friend class to allow direct access if needed, OR just use setters.
@@ -90,183 +127,250 @@ public:
 
 class AppointmentQueue {
 private:
-    // Inner class for linked queue node
-    class QueueNode {
-    public:
+    /**
+     * One heap slot: the appointment plus its arrival sequence
+     * number (the FIFO tiebreak for equal priorities)
+     */
+    struct HeapEntry {
         Appointment data;
-        QueueNode* next;
-
-        QueueNode(const Appointment& appt) : data(appt), next(nullptr) {}
+        long long seq;
     };
 
-    QueueNode* front;  // Pointer to front of queue (for dequeue)
-    QueueNode* rear;   // Pointer to rear of queue (for enqueue)
-    int size;          // Number of appointments in queue
+    std::vector<HeapEntry> heap;  // Binary min-heap, root at index 0
+    long long nextSeq;            // Monotonic arrival counter
+    IntHashSet members;           // Patient IDs currently waiting
 
 public:
+    // Re-exported so callers don't hard-code the convention
+    static constexpr int DEFAULT_PRIORITY = DEFAULT_APPOINTMENT_PRIORITY;
+
     /**
      * Constructor - Initialize empty queue
      */
-    AppointmentQueue() : front(nullptr), rear(nullptr), size(0) {}
+    AppointmentQueue() : nextSeq(0) {}
 
     /**
-     * Destructor - Free all memory
+     * Enqueue - Add patient at default priority (pure FIFO behavior)
+     *
+     * @param appointment The appointment to add
+     *
+     * Time: O(log n) | Space: O(1) amortized
      */
-    ~AppointmentQueue() {
-        while (front != nullptr) {
-            QueueNode* toDelete = front;
-            front = front->next;
-            delete toDelete;
-        }
+    void enqueue(const Appointment& appointment) {
+        enqueueWithPriority(appointment, DEFAULT_PRIORITY);
     }
 
     /**
-     * Enqueue - Add patient to appointment queue (at rear)
-     * 
-     * @param appointment The appointment to add
-     * 
-     * Time: O(1) | Space: O(1)
+     * Enqueue with an explicit triage priority (lower = more urgent)
+     *
+     * Time: O(log n) | Space: O(1) amortized
      */
-    void enqueue(const Appointment& appointment) {
-        QueueNode* newNode = new QueueNode(appointment);
-        // data is a copy, need to set position on the stored copy
-        newNode->data.setPosition(size + 1);  // Set position
+    void enqueueWithPriority(const Appointment& appointment, int priority) {
+        heap.push_back({appointment, nextSeq++});
+        heap.back().data.setPriority(priority);
+        members.add(appointment.getPatientId());
+        siftUp(heap.size() - 1);
+    }
 
-        if (isEmpty()) {
-            front = rear = newNode;
-        } else {
-            rear->next = newNode;
-            rear = newNode;
+    /**
+     * Change a waiting patient's priority and re-sift them into place
+     *
+     * @return true if the patient was in the queue
+     *
+     * Time: O(n) to locate + O(log n) to re-sift
+     */
+    bool changePriority(int patientId, int newPriority) {
+        for (std::size_t i = 0; i < heap.size(); i++) {
+            if (heap[i].data.getPatientId() == patientId) {
+                int oldPriority = heap[i].data.getPriority();
+                heap[i].data.setPriority(newPriority);
+                if (newPriority < oldPriority) {
+                    siftUp(i);
+                } else if (newPriority > oldPriority) {
+                    siftDown(i);
+                }
+                return true;
+            }
         }
-        size++;
+        return false;
     }
 
     /**
-     * Dequeue - Remove and return patient from front (next to be served)
-     * 
+     * Dequeue - Remove and return the most urgent patient
+     * (earliest arrival among equal priorities)
+     *
      * @return The appointment being processed
-     * 
-     * Time: O(1) | Space: O(1)
+     *
+     * Time: O(log n) | Space: O(1)
      */
     Appointment dequeue() {
         if (isEmpty()) {
             return Appointment(); // Return empty appointment
         }
 
-        QueueNode* toDelete = front;
-        Appointment result = front->data;
-        front = front->next;
-
-        if (front == nullptr) {
-            rear = nullptr; // Queue is now empty
+        Appointment result = heap[0].data;
+        result.setPosition(1);
+        members.remove(result.getPatientId());
+        heap[0] = heap.back();
+        heap.pop_back();
+        if (!heap.empty()) {
+            siftDown(0);
         }
-
-        delete toDelete;
-        size--;
-
-        // Update positions for remaining patients
-        updatePositions();
-
         return result;
     }
 
     /**
-     * Peek at front appointment without removing
-     * 
-     * @return Reference to front appointment
-     * 
+     * Peek at the next appointment without removing
+     *
      * Time: O(1) | Space: O(1)
      */
     Appointment peekFront() const {
         if (isEmpty()) {
             return Appointment();
         }
-        return front->data;
+        Appointment result = heap[0].data;
+        result.setPosition(1);
+        return result;
     }
 
     /**
      * Check if queue is empty
      */
     bool isEmpty() const {
-        return front == nullptr;
+        return heap.empty();
     }
 
     /**
      * Get current queue size (number of waiting patients)
      */
     int getSize() const {
-        return size;
+        return static_cast<int>(heap.size());
     }
 
     /**
-     * Get all appointments in queue as JSON array (front to rear)
-     * 
-     * Time: O(n) | Space: O(n)
+     * Get all appointments as JSON array in service order
+     * (most urgent first, FIFO within a priority)
+     *
+     * Time: O(n log n) | Space: O(n)
      */
     std::string getWaitingListJSON() const {
-        std::stringstream ss;
-        ss << "[";
-        QueueNode* current = front;
-        bool first = true;
-        while (current != nullptr) {
-            if (!first) ss << ",";
-            ss << current->data.toJSON();
-            first = false;
-            current = current->next;
+        std::vector<HeapEntry> ordered = heap;
+        std::sort(ordered.begin(), ordered.end(),
+                  [](const HeapEntry& a, const HeapEntry& b) {
+                      return entryBefore(a, b);
+                  });
+
+        std::string out;
+        out.reserve(ordered.size() * 180 + 2);
+        out += "[";
+        for (std::size_t i = 0; i < ordered.size(); i++) {
+            if (i > 0) out += ",";
+            ordered[i].data.setPosition(static_cast<int>(i) + 1);
+            ordered[i].data.appendJSON(out);
         }
-        ss << "]";
-        return ss.str();
+        out += "]";
+        return out;
     }
 
     /**
-     * Check if patient is already in queue
-     * 
-     * Time: O(n) | Space: O(1)
+     * Check if patient is already in queue (hash-set membership -
+     * no walk over the heap)
+     *
+     * Time: O(1) average | Space: O(1)
      */
     bool isInQueue(int patientId) const {
-        QueueNode* current = front;
-        while (current != nullptr) {
-            if (current->data.getPatientId() == patientId) {
-                return true;
-            }
-            current = current->next;
-        }
-        return false;
+        return members.contains(patientId);
     }
 
     /**
-     * Get patient's position in queue
-     * 
+     * Get patient's position in service order (1 = served next)
+     *
+     * The membership set answers "not here" in O(1); for a waiting
+     * patient the rank is one counting pass over the heap array -
+     * no sort, no allocation, no JSON, unlike deriving it from
+     * getWaitingListJSON.
+     *
      * @return Position (1-indexed) or -1 if not found
-     * 
-     * Time: O(n) | Space: O(1)
+     *
+     * Time: O(1) miss, O(n) hit | Space: O(1)
      */
-    int getPosition(int patientId) const {
-        QueueNode* current = front;
-        int pos = 1;
-        while (current != nullptr) {
-            if (current->data.getPatientId() == patientId) {
-                return pos;
+    int getPositionOf(int patientId) const {
+        if (!members.contains(patientId)) return -1;
+
+        std::size_t target = heap.size();
+        for (std::size_t i = 0; i < heap.size(); i++) {
+            if (heap[i].data.getPatientId() == patientId) {
+                target = i;
+                break;
             }
-            current = current->next;
-            pos++;
         }
-        return -1;
+        if (target == heap.size()) return -1;
+
+        // Rank = how many entries would be served before this one
+        int rank = 1;
+        for (std::size_t i = 0; i < heap.size(); i++) {
+            if (i != target && entryBefore(heap[i], heap[target])) {
+                rank++;
+            }
+        }
+        return rank;
+    }
+
+    /**
+     * Longstanding name for getPositionOf, kept for existing callers
+     */
+    int getPosition(int patientId) const {
+        return getPositionOf(patientId);
     }
 
 private:
     /**
-     * Update positions of all patients in queue
-     * Called after dequeue operation
-     * 
-     * Time: O(n)
+     * Heap ordering: lower priority value first, then earlier
+     * arrival (the FIFO tiebreak)
+     */
+    static bool entryBefore(const HeapEntry& a, const HeapEntry& b) {
+        if (a.data.getPriority() != b.data.getPriority()) {
+            return a.data.getPriority() < b.data.getPriority();
+        }
+        return a.seq < b.seq;
+    }
+
+    /**
+     * Bubble an entry up toward the root until the heap property
+     * holds again
+     *
+     * Time: O(log n)
      */
-    void updatePositions() {
-        QueueNode* current = front;
-        int pos = 1;
-        while (current != nullptr) {
-            current->data.setPosition(pos++);
-            current = current->next;
+    void siftUp(std::size_t index) {
+        while (index > 0) {
+            std::size_t parent = (index - 1) / 2;
+            if (!entryBefore(heap[index], heap[parent])) break;
+            std::swap(heap[index], heap[parent]);
+            index = parent;
+        }
+    }
+
+    /**
+     * Push an entry down toward the leaves until the heap property
+     * holds again
+     *
+     * Time: O(log n)
+     */
+    void siftDown(std::size_t index) {
+        std::size_t count = heap.size();
+        while (true) {
+            std::size_t left = 2 * index + 1;
+            std::size_t right = left + 1;
+            std::size_t smallest = index;
+            if (left < count && entryBefore(heap[left], heap[smallest])) {
+                smallest = left;
+            }
+            if (right < count && entryBefore(heap[right], heap[smallest])) {
+                smallest = right;
+            }
+            if (smallest == index) break;
+            std::swap(heap[index], heap[smallest]);
+            index = smallest;
         }
     }
 };
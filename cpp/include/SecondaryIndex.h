@@ -0,0 +1,479 @@
+#ifndef SECONDARY_INDEX_H
+#define SECONDARY_INDEX_H
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * Secondary Indexes for Non-ID Patient Fields
+ * ============================================
+ *
+ * WHY SECONDARY INDEXES?
+ * ----------------------
+ * The only indexed field used to be patientId, so a query like
+ * "all patients with disease X" had to serialize the entire data
+ * set and filter it on the other side - a full O(n) scan for a
+ * query matching a handful of records. These structures map field
+ * values back to patient IDs so such queries cost time proportional
+ * to the result size.
+ *
+ * TWO SHAPES FOR TWO QUERY KINDS:
+ * -------------------------------
+ * 1. StringHashIndex - exact-match lookups (disease, gender).
+ *    Open-addressing hash table from field value to the list of
+ *    patient IDs holding that value. O(1) per lookup.
+ *
+ * 2. StringOrderedIndex - ordered lookups (name prefix, date
+ *    ranges). An AVL tree keyed on the string value, supporting
+ *    prefix scans ("names starting with 'ali'") and range scans
+ *    ("appointments between two dates") in O(log n + matches).
+ *
+ * Both are multimaps: one value maps to many patient IDs, stored
+ * as a flat vector per entry (removal is swap-with-last, O(ids)).
+ * The PatientManager keeps them in sync inside add/update/delete.
+ */
+
+/**
+ * Open-addressing hash multimap: field value -> patient IDs
+ * (same linear-probing/tombstone scheme as PatientHashMap, with
+ * FNV-1a for string keys)
+ */
+class StringHashIndex {
+private:
+    enum SlotState : unsigned char { EMPTY, OCCUPIED, DELETED };
+
+    struct Slot {
+        std::string key;
+        std::vector<int> ids;
+        SlotState state;
+
+        Slot() : state(EMPTY) {}
+    };
+
+    Slot* table;
+    int capacity;   // Always a power of two
+    int count;      // Occupied slots (distinct values)
+    int usedSlots;  // Occupied + tombstones
+
+    static const int INITIAL_CAPACITY = 64;
+
+public:
+    StringHashIndex() : capacity(INITIAL_CAPACITY), count(0), usedSlots(0) {
+        table = new Slot[capacity];
+    }
+
+    ~StringHashIndex() {
+        delete[] table;
+    }
+
+    StringHashIndex(const StringHashIndex&) = delete;
+    StringHashIndex& operator=(const StringHashIndex&) = delete;
+
+    /**
+     * Add a (value, patientId) association
+     *
+     * Time: O(1) average
+     */
+    void add(const std::string& key, int patientId) {
+        if ((usedSlots + 1) * 10 >= capacity * 7) {
+            rehash(capacity * 2);
+        }
+
+        int index = probeFor(key);
+        if (table[index].state != OCCUPIED) {
+            if (table[index].state == EMPTY) {
+                usedSlots++;
+            }
+            table[index].key = key;
+            table[index].ids.clear();
+            table[index].state = OCCUPIED;
+            count++;
+        }
+        table[index].ids.push_back(patientId);
+    }
+
+    /**
+     * Remove one (value, patientId) association
+     *
+     * Time: O(1) average + O(ids with this value)
+     */
+    void remove(const std::string& key, int patientId) {
+        int index = probeFor(key);
+        if (table[index].state != OCCUPIED) return;
+
+        std::vector<int>& ids = table[index].ids;
+        for (std::size_t i = 0; i < ids.size(); i++) {
+            if (ids[i] == patientId) {
+                ids[i] = ids.back();  // Swap-with-last, order not needed
+                ids.pop_back();
+                break;
+            }
+        }
+        if (ids.empty()) {
+            table[index].key.clear();
+            table[index].state = DELETED;
+            count--;
+        }
+    }
+
+    /**
+     * Collect all patient IDs holding this value
+     *
+     * Time: O(1) average + O(matches)
+     */
+    void collect(const std::string& key, std::vector<int>& out) const {
+        int index = probeFor(key);
+        if (table[index].state == OCCUPIED) {
+            out.insert(out.end(), table[index].ids.begin(), table[index].ids.end());
+        }
+    }
+
+    /**
+     * Number of distinct values indexed
+     */
+    int getDistinctCount() const {
+        return count;
+    }
+
+    /**
+     * Visit every (value, id-count) pair - lets callers read value
+     * frequencies straight off the index instead of re-counting
+     * records (iteration order is unspecified)
+     */
+    template <typename Fn>
+    void forEachEntry(Fn visit) const {
+        for (int i = 0; i < capacity; i++) {
+            if (table[i].state == OCCUPIED) {
+                visit(table[i].key, static_cast<long long>(table[i].ids.size()));
+            }
+        }
+    }
+
+private:
+    /**
+     * FNV-1a string hash
+     */
+    static std::size_t hashKey(const std::string& key) {
+        std::size_t h = 1469598103934665603ull;
+        for (char c : key) {
+            h ^= static_cast<unsigned char>(c);
+            h *= 1099511628211ull;
+        }
+        return h;
+    }
+
+    int probeFor(const std::string& key) const {
+        std::size_t mask = static_cast<std::size_t>(capacity - 1);
+        std::size_t index = hashKey(key) & mask;
+        int firstDeleted = -1;
+
+        while (true) {
+            const Slot& slot = table[index];
+            if (slot.state == EMPTY) {
+                return (firstDeleted >= 0) ? firstDeleted : static_cast<int>(index);
+            }
+            if (slot.state == OCCUPIED && slot.key == key) {
+                return static_cast<int>(index);
+            }
+            if (slot.state == DELETED && firstDeleted < 0) {
+                firstDeleted = static_cast<int>(index);
+            }
+            index = (index + 1) & mask;
+        }
+    }
+
+    void rehash(int newCapacity) {
+        Slot* oldTable = table;
+        int oldCapacity = capacity;
+
+        table = new Slot[newCapacity];
+        capacity = newCapacity;
+        count = 0;
+        usedSlots = 0;
+
+        for (int i = 0; i < oldCapacity; i++) {
+            if (oldTable[i].state == OCCUPIED) {
+                for (int id : oldTable[i].ids) {
+                    add(oldTable[i].key, id);
+                }
+            }
+        }
+        delete[] oldTable;
+    }
+};
+
+/**
+ * AVL-tree multimap keyed on a string field, for prefix and range
+ * queries (same balancing scheme as PatientBST)
+ */
+class StringOrderedIndex {
+private:
+    struct IndexNode {
+        std::string key;
+        std::vector<int> ids;
+        IndexNode* left;
+        IndexNode* right;
+        int height;
+
+        IndexNode(const std::string& k, int id)
+            : key(k), left(nullptr), right(nullptr), height(1) {
+            ids.push_back(id);
+        }
+    };
+
+    IndexNode* root;
+    int size;  // Distinct keys
+
+public:
+    StringOrderedIndex() : root(nullptr), size(0) {}
+
+    ~StringOrderedIndex() {
+        destroy(root);
+    }
+
+    StringOrderedIndex(const StringOrderedIndex&) = delete;
+    StringOrderedIndex& operator=(const StringOrderedIndex&) = delete;
+
+    /**
+     * Add a (value, patientId) association
+     *
+     * Time: O(log n)
+     */
+    void add(const std::string& key, int patientId) {
+        root = insertRecursive(root, key, patientId);
+    }
+
+    /**
+     * Remove one (value, patientId) association; the key's node is
+     * deleted (with rebalancing) once its last ID is gone
+     *
+     * Time: O(log n + ids with this value)
+     */
+    void remove(const std::string& key, int patientId) {
+        root = removeRecursive(root, key, patientId);
+    }
+
+    /**
+     * Collect patient IDs for every key starting with 'prefix',
+     * in key order
+     *
+     * Time: O(log n + matches)
+     */
+    void collectPrefix(const std::string& prefix, std::vector<int>& out) const {
+        collectPrefixHelper(root, prefix, out);
+    }
+
+    /**
+     * Collect patient IDs for every key in [lo, hi] inclusive,
+     * in key order
+     *
+     * Time: O(log n + matches)
+     */
+    void collectRange(const std::string& lo, const std::string& hi,
+                      std::vector<int>& out) const {
+        collectRangeHelper(root, lo, hi, out);
+    }
+
+    /**
+     * Number of distinct keys indexed
+     */
+    int getDistinctCount() const {
+        return size;
+    }
+
+    /**
+     * Visit every (key, id-count) pair in key order - gives callers
+     * a ready-sorted frequency histogram
+     */
+    template <typename Fn>
+    void forEachKeyInOrder(Fn visit) const {
+        forEachHelper(root, visit);
+    }
+
+private:
+    template <typename Fn>
+    void forEachHelper(IndexNode* node, Fn& visit) const {
+        if (node == nullptr) return;
+        forEachHelper(node->left, visit);
+        visit(node->key, static_cast<long long>(node->ids.size()));
+        forEachHelper(node->right, visit);
+    }
+
+    // ---- AVL plumbing (mirrors PatientBST) ----
+
+    int nodeHeight(IndexNode* node) const {
+        return (node == nullptr) ? 0 : node->height;
+    }
+
+    int balanceFactor(IndexNode* node) const {
+        return (node == nullptr) ? 0 : nodeHeight(node->left) - nodeHeight(node->right);
+    }
+
+    void updateHeight(IndexNode* node) {
+        int leftHeight = nodeHeight(node->left);
+        int rightHeight = nodeHeight(node->right);
+        node->height = 1 + (leftHeight > rightHeight ? leftHeight : rightHeight);
+    }
+
+    IndexNode* rotateRight(IndexNode* y) {
+        IndexNode* x = y->left;
+        y->left = x->right;
+        x->right = y;
+        updateHeight(y);
+        updateHeight(x);
+        return x;
+    }
+
+    IndexNode* rotateLeft(IndexNode* x) {
+        IndexNode* y = x->right;
+        x->right = y->left;
+        y->left = x;
+        updateHeight(x);
+        updateHeight(y);
+        return y;
+    }
+
+    IndexNode* rebalance(IndexNode* node) {
+        updateHeight(node);
+        int balance = balanceFactor(node);
+        if (balance > 1) {
+            if (balanceFactor(node->left) < 0) {
+                node->left = rotateLeft(node->left);
+            }
+            return rotateRight(node);
+        }
+        if (balance < -1) {
+            if (balanceFactor(node->right) > 0) {
+                node->right = rotateRight(node->right);
+            }
+            return rotateLeft(node);
+        }
+        return node;
+    }
+
+    IndexNode* insertRecursive(IndexNode* node, const std::string& key, int id) {
+        if (node == nullptr) {
+            size++;
+            return new IndexNode(key, id);
+        }
+        if (key < node->key) {
+            node->left = insertRecursive(node->left, key, id);
+        } else if (key > node->key) {
+            node->right = insertRecursive(node->right, key, id);
+        } else {
+            node->ids.push_back(id);  // Existing key - just extend
+            return node;
+        }
+        return rebalance(node);
+    }
+
+    IndexNode* removeRecursive(IndexNode* node, const std::string& key, int id) {
+        if (node == nullptr) return nullptr;
+
+        if (key < node->key) {
+            node->left = removeRecursive(node->left, key, id);
+        } else if (key > node->key) {
+            node->right = removeRecursive(node->right, key, id);
+        } else {
+            // Drop this ID from the entry
+            std::vector<int>& ids = node->ids;
+            for (std::size_t i = 0; i < ids.size(); i++) {
+                if (ids[i] == id) {
+                    ids[i] = ids.back();
+                    ids.pop_back();
+                    break;
+                }
+            }
+            if (!ids.empty()) {
+                return node;  // Key still live
+            }
+
+            // Last ID gone - remove the node itself
+            size--;
+            if (node->left == nullptr || node->right == nullptr) {
+                IndexNode* child = (node->left != nullptr) ? node->left : node->right;
+                delete node;
+                return child;
+            }
+            // Two children: splice in the in-order successor
+            IndexNode* successor = node->right;
+            while (successor->left != nullptr) successor = successor->left;
+            node->key = successor->key;
+            node->ids.swap(successor->ids);
+            successor->ids.clear();
+            size++;  // Compensate - the recursive call decrements again
+            node->right = removeAll(node->right, node->key);
+        }
+        return rebalance(node);
+    }
+
+    /**
+     * Remove a node outright by key (used to extract the successor
+     * after its contents were spliced upward)
+     */
+    IndexNode* removeAll(IndexNode* node, const std::string& key) {
+        if (node == nullptr) return nullptr;
+        if (key < node->key) {
+            node->left = removeAll(node->left, key);
+        } else if (key > node->key) {
+            node->right = removeAll(node->right, key);
+        } else {
+            size--;
+            if (node->left == nullptr || node->right == nullptr) {
+                IndexNode* child = (node->left != nullptr) ? node->left : node->right;
+                delete node;
+                return child;
+            }
+            IndexNode* successor = node->right;
+            while (successor->left != nullptr) successor = successor->left;
+            node->key = successor->key;
+            node->ids.swap(successor->ids);
+            size++;
+            node->right = removeAll(node->right, node->key);
+        }
+        return rebalance(node);
+    }
+
+    void collectPrefixHelper(IndexNode* node, const std::string& prefix,
+                             std::vector<int>& out) const {
+        if (node == nullptr) return;
+
+        // Compare the first prefix-length characters of this key
+        int cmp = node->key.compare(0, prefix.size(), prefix);
+        if (cmp < 0) {
+            collectPrefixHelper(node->right, prefix, out);  // Key too small
+        } else if (cmp > 0) {
+            collectPrefixHelper(node->left, prefix, out);   // Key too large
+        } else {
+            // Key starts with the prefix - both sides may match too
+            collectPrefixHelper(node->left, prefix, out);
+            out.insert(out.end(), node->ids.begin(), node->ids.end());
+            collectPrefixHelper(node->right, prefix, out);
+        }
+    }
+
+    void collectRangeHelper(IndexNode* node, const std::string& lo,
+                            const std::string& hi, std::vector<int>& out) const {
+        if (node == nullptr) return;
+
+        if (node->key > lo) {
+            collectRangeHelper(node->left, lo, hi, out);
+        }
+        if (node->key >= lo && node->key <= hi) {
+            out.insert(out.end(), node->ids.begin(), node->ids.end());
+        }
+        if (node->key < hi) {
+            collectRangeHelper(node->right, lo, hi, out);
+        }
+    }
+
+    void destroy(IndexNode* node) {
+        if (node == nullptr) return;
+        destroy(node->left);
+        destroy(node->right);
+        delete node;
+    }
+};
+
+#endif // SECONDARY_INDEX_H
@@ -0,0 +1,181 @@
+#ifndef SHARDED_MANAGER_H
+#define SHARDED_MANAGER_H
+
+#include "PatientManager.h"
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+/**
+ * Sharded Patient Manager (multi-tenant facade)
+ * =============================================
+ *
+ * WHY SHARD?
+ * ----------
+ * One process serves many clinics. Running them through a single
+ * PatientManager funnels every clinic's traffic through one
+ * reader-writer lock and one set of caches; running 40 separate
+ * Python-level managers duplicates infrastructure and loses any
+ * cross-clinic view. This facade owns a fixed array of
+ * PatientManager shards, routed by a clinic key:
+ *
+ * 1. Isolation: Each shard has its own lock, caches, indexes and
+ *    activity log - one clinic's bulk import never stalls
+ *    another's reads.
+ *
+ * 2. Parallelism: Traffic for different clinics proceeds on
+ *    different shards concurrently; cross-shard operations fan
+ *    out across threads.
+ *
+ * 3. Shared Cold Infrastructure: The string intern pool
+ *    (Intern.h) and the perf-stats registry (PerfStats.h) are
+ *    process-wide by design, so shards share one copy of every
+ *    distinct disease/gender/date value instead of 40.
+ *
+ * ROUTING:
+ * --------
+ * shardFor(clinicKey) hashes the key onto a power-of-two shard
+ * array (same Fibonacci hash as the hash map). Patient IDs are
+ * per-shard (each shard numbers from 1001), so a record is always
+ * addressed as (clinicKey, patientId) - exactly how the callers
+ * already model their tenants.
+ */
+
+class ShardedPatientManager {
+private:
+    std::vector<std::unique_ptr<PatientManager>> shards;
+    unsigned int mask;  // shardCount - 1 (power of two)
+
+public:
+    /**
+     * @param shardCount Number of shards (rounded up to a power of
+     *                   two so routing is a mask, not a modulo)
+     */
+    explicit ShardedPatientManager(int shardCount = 16) {
+        unsigned int count = 1;
+        while (count < static_cast<unsigned int>(shardCount > 1 ? shardCount : 1)) {
+            count <<= 1;
+        }
+        mask = count - 1;
+        shards.reserve(count);
+        for (unsigned int i = 0; i < count; i++) {
+            shards.emplace_back(new PatientManager());
+        }
+    }
+
+    ShardedPatientManager(const ShardedPatientManager&) = delete;
+    ShardedPatientManager& operator=(const ShardedPatientManager&) = delete;
+
+    /**
+     * The shard owning a clinic key - callers use the full
+     * PatientManager API on it (per-clinic operations never touch
+     * another shard's lock)
+     */
+    PatientManager& shardFor(int clinicKey) {
+        return *shards[hashKey(clinicKey) & mask];
+    }
+
+    int getShardCount() const {
+        return static_cast<int>(shards.size());
+    }
+
+    /**
+     * Cross-shard statistics fan-out: native counters summed over
+     * every shard, plus the per-shard breakdown
+     */
+    std::string getStatistics() const {
+        long long totalPatients = 0;
+        long long totalQueued = 0;
+
+        std::string perShard;
+        perShard.reserve(shards.size() * 48 + 2);
+        perShard += "[";
+        for (std::size_t i = 0; i < shards.size(); i++) {
+            int patients = shards[i]->getPatientCount();
+            int queued = shards[i]->getQueueSize();
+            totalPatients += patients;
+            totalQueued += queued;
+
+            if (i > 0) perShard += ",";
+            perShard += "{\"shard\":";
+            jsonutil::appendInt(perShard, static_cast<long long>(i));
+            perShard += ",\"patients\":";
+            jsonutil::appendInt(perShard, patients);
+            perShard += ",\"queueSize\":";
+            jsonutil::appendInt(perShard, queued);
+            perShard += "}";
+        }
+        perShard += "]";
+
+        std::string out;
+        out.reserve(128 + perShard.size());
+        out += "{\"success\":true,\"shards\":";
+        jsonutil::appendInt(out, static_cast<long long>(shards.size()));
+        out += ",\"totalPatients\":";
+        jsonutil::appendInt(out, totalPatients);
+        out += ",\"queueSize\":";
+        jsonutil::appendInt(out, totalQueued);
+        out += ",\"perShard\":";
+        out += perShard;
+        out += ",\"perf\":";
+        out += perf::statsJSON();  // Registry is process-wide
+        out += "}";
+        return out;
+    }
+
+    /**
+     * Global export: every shard renders its own records on its
+     * own thread (each against its own snapshot - see
+     * exportPatientsJSON), then the shard arrays are concatenated
+     * into one. 40 clinics become 40-way parallel rendering.
+     */
+    std::string exportAllPatientsJSON() {
+        std::vector<std::string> dumps(shards.size());
+
+        std::vector<std::thread> pool;
+        pool.reserve(shards.size() - 1);
+        for (std::size_t i = 1; i < shards.size(); i++) {
+            pool.emplace_back([this, &dumps, i] {
+                // Single-threaded per shard - the parallelism here
+                // is across shards
+                dumps[i] = shards[i]->exportPatientsJSON(1);
+            });
+        }
+        dumps[0] = shards[0]->exportPatientsJSON(1);
+        for (std::thread& t : pool) {
+            t.join();
+        }
+
+        std::size_t bytes = 2 + shards.size();
+        for (const std::string& dump : dumps) bytes += dump.size();
+        std::string out;
+        out.reserve(bytes);
+        out += "[";
+        bool first = true;
+        for (const std::string& dump : dumps) {
+            // Each dump is "[...]" - splice out the brackets
+            if (dump.size() <= 2) continue;
+            if (!first) out += ",";
+            out.append(dump, 1, dump.size() - 2);
+            first = false;
+        }
+        out += "]";
+        return out;
+    }
+
+private:
+    /**
+     * Same Fibonacci hash as PatientHashMap - clinic keys are
+     * often sequential and must not cluster on one shard
+     */
+    static unsigned int hashKey(int key) {
+        unsigned int h = static_cast<unsigned int>(key);
+        h ^= h >> 16;
+        h *= 0x9E3779B9u;
+        h ^= h >> 15;
+        return h;
+    }
+};
+
+#endif // SHARDED_MANAGER_H
@@ -1,8 +1,10 @@
 #ifndef STACK_H
 #define STACK_H
 
+#include "JsonUtil.h"
+#include "Patient.h"
 #include <string>
-#include <sstream>
+#include <utility>
 #include <ctime>
 
 /**
@@ -45,95 +47,158 @@ private:
     std::string action;      // Action type: "ADD", "DELETE", "UPDATE", "VIEW", "QUEUE"
     int patientId;           // Related patient ID
     std::string patientName; // Patient name for display
-    std::string timestamp;   // When the action occurred
+    long long timestamp;     // When the action occurred (epoch seconds)
     std::string details;     // Additional details
 
+    // Undo support: mutations carry enough state to be reversed
+    // natively. ADD needs only the ID; UPDATE and DELETE carry the
+    // record as it was BEFORE the operation. Memory stays bounded
+    // because these live in the same fixed-capacity ring as every
+    // other activity.
+    Patient beforeImage;     // Pre-operation record (UPDATE/DELETE)
+    bool undoable;           // This entry can be reversed
+    bool undone;             // Already reversed (kept for the audit)
+
 public:
-    Activity() : patientId(0) {}
+    Activity() : patientId(0), timestamp(0), undoable(false), undone(false) {}
+
+    Activity(std::string act, int id, std::string name,
+             std::string det = "")
+        : action(std::move(act)), patientId(id),
+          patientName(std::move(name)),
+          timestamp(static_cast<long long>(time(nullptr))),
+          details(std::move(det)),
+          undoable(false), undone(false) {
+        // Just a clock read - the human-readable form is rendered
+        // (and cached per second) in appendJSON, not on every
+        // construction
+    }
+
+    /**
+     * Mark this entry reversible without a before-image (ADD - the
+     * inverse only needs the patient ID)
+     */
+    void markUndoable() {
+        undoable = true;
+    }
 
-    Activity(const std::string& act, int id, const std::string& name, 
-             const std::string& det = "")
-        : action(act), patientId(id), patientName(name), details(det) {
-        // Generate timestamp
-        time_t now = time(nullptr);
-        char buf[80];
-        strftime(buf, sizeof(buf), "%Y-%m-%d %H:%M:%S", localtime(&now));
-        timestamp = std::string(buf);
+    /**
+     * Attach the pre-operation record (UPDATE/DELETE - the inverse
+     * restores it), which also marks the entry reversible
+     */
+    void attachBeforeImage(const Patient& image) {
+        beforeImage = image;
+        undoable = true;
+    }
+
+    const std::string& getAction() const { return action; }
+    int getPatientId() const { return patientId; }
+    const std::string& getPatientName() const { return patientName; }
+    const Patient& getBeforeImage() const { return beforeImage; }
+    bool isUndoable() const { return undoable; }
+    bool isUndone() const { return undone; }
+
+    /**
+     * Record that this entry has been reversed (it stays in the
+     * audit trail but can't be undone twice)
+     */
+    void markUndone() {
+        undone = true;
+    }
+
+    /**
+     * Append as a JSON object into a caller-provided buffer
+     */
+    void appendJSON(std::string& out) const {
+        out += "{\"action\":\"";
+        jsonutil::appendEscaped(out, action);
+        out += "\",\"patientId\":";
+        jsonutil::appendInt(out, patientId);
+        out += ",\"patientName\":\"";
+        jsonutil::appendEscaped(out, patientName);
+        out += "\",\"timestamp\":\"";
+        jsonutil::appendTimestamp(out, timestamp);
+        out += "\",\"details\":\"";
+        jsonutil::appendEscaped(out, details);
+        out += "\"";
+        if (undone) {
+            out += ",\"undone\":true";
+        }
+        out += "}";
     }
 
     std::string toJSON() const {
-        std::stringstream ss;
-        ss << "{";
-        ss << "\"action\":\"" << action << "\",";
-        ss << "\"patientId\":" << patientId << ",";
-        ss << "\"patientName\":\"" << patientName << "\",";
-        ss << "\"timestamp\":\"" << timestamp << "\",";
-        ss << "\"details\":\"" << details << "\"";
-        ss << "}";
-        return ss.str();
+        std::string out;
+        out.reserve(160);
+        appendJSON(out);
+        return out;
     }
     
     // Getters if needed in future, currently toJSON is primary access
 };
 
+/**
+ * Fixed-capacity ring buffer behind the same stack interface.
+ *
+ * The old implementation heap-allocated one node per push and, once
+ * full, walked the whole list to trim the oldest entry - so a busy
+ * audit trail paid an allocation plus an O(n) scan per event. The
+ * ring stores activities in one flat array allocated up front:
+ * - push is O(1) and allocation-free (slots are reused in place,
+ *   and a reused std::string keeps its capacity)
+ * - when full, the oldest entry is overwritten - no trimming pass
+ * - readers walk backwards from the write head, so LIFO order is
+ *   preserved exactly as before
+ *
+ * The buffer itself is single-writer-at-a-time; callers serialize
+ * access (PatientManager guards it with its activity mutex).
+ */
 class ActivityStack {
 private:
-    // Inner class for stack node
-    class ActivityNode {
-    public:
-        Activity data;
-        ActivityNode* next;
-
-        ActivityNode(const Activity& act) : data(act), next(nullptr) {}
-    };
-
-    ActivityNode* top;  // Pointer to top of stack
-    int size;           // Number of activities
-    int maxSize;        // Maximum activities to keep (to prevent memory issues)
+    Activity* slots;  // Flat circular array of 'capacity' entries
+    int capacity;     // Fixed slot count (oldest overwritten when full)
+    int head;         // Index of the NEXT slot to write
+    int size;         // Live entries (<= capacity)
 
 public:
     /**
      * Constructor
-     * @param max Maximum number of activities to store (default 100)
+     * @param max Maximum number of activities to keep (default 100);
+     *            older entries are overwritten once the buffer fills
      */
-    ActivityStack(int max = 100) : top(nullptr), size(0), maxSize(max) {}
+    ActivityStack(int max = 100)
+        : capacity(max > 0 ? max : 1), head(0), size(0) {
+        slots = new Activity[capacity];
+    }
 
     /**
-     * Destructor - Free all memory
+     * Destructor - Free the slot array
      */
     ~ActivityStack() {
-        while (top != nullptr) {
-            ActivityNode* toDelete = top;
-            top = top->next;
-            delete toDelete;
-        }
+        delete[] slots;
     }
 
+    ActivityStack(const ActivityStack&) = delete;
+    ActivityStack& operator=(const ActivityStack&) = delete;
+
     /**
-     * Push new activity onto stack
-     * If stack is full, removes oldest activity
-     * 
-     * @param activity The activity to record
-     * 
-     * Time: O(1) | Space: O(1)
+     * Push new activity (overwrites the oldest entry when full)
+     *
+     * Time: O(1) | Space: O(1) - no allocation
      */
     void push(const Activity& activity) {
-        ActivityNode* newNode = new ActivityNode(activity);
-        newNode->next = top;
-        top = newNode;
-        size++;
-
-        // If exceeds max size, trim from bottom
-        if (size > maxSize) {
-            trimOldest();
+        slots[head] = activity;
+        head = (head + 1) % capacity;
+        if (size < capacity) {
+            size++;
         }
     }
 
     /**
-     * Pop (remove) top activity from stack
-     * 
+     * Pop (remove) the most recent activity
+     *
      * @return The removed activity
-     * 
+     *
      * Time: O(1) | Space: O(1)
      */
     Activity pop() {
@@ -141,103 +206,87 @@ public:
             return Activity(); // Return empty activity
         }
 
-        ActivityNode* toDelete = top;
-        Activity result = top->data;
-        top = top->next;
-        delete toDelete;
+        head = (head - 1 + capacity) % capacity;
         size--;
-        return result;
+        return slots[head];
     }
 
     /**
-     * Peek at top activity without removing
-     * 
-     * @return Reference to top activity
-     * 
+     * Peek at the most recent activity without removing
+     *
      * Time: O(1) | Space: O(1)
      */
     Activity peek() const {
         if (isEmpty()) {
             return Activity();
         }
-        return top->data;
+        return slots[(head - 1 + capacity) % capacity];
     }
 
     /**
-     * Check if stack is empty
+     * Check if the buffer is empty
      */
     bool isEmpty() const {
-        return top == nullptr;
+        return size == 0;
     }
 
     /**
-     * Get current stack size
+     * Get current entry count
      */
     int getSize() const {
         return size;
     }
 
     /**
-     * Get all activities as JSON array (top to bottom)
-     * 
-     * Time: O(n) | Space: O(n)
+     * Find the most recent entry that can still be reversed,
+     * scanning backwards from the write head (the audit trail is
+     * left intact - the caller marks the entry undone in place)
+     *
+     * @return Pointer into the ring, or nullptr if nothing to undo
+     *
+     * Time: O(capacity) worst case
      */
-    std::string getAllActivitiesJSON() const {
-        std::stringstream ss;
-        ss << "[";
-        ActivityNode* current = top;
-        bool first = true;
-        while (current != nullptr) {
-            if (!first) ss << ",";
-            ss << current->data.toJSON();
-            first = false;
-            current = current->next;
+    Activity* latestUndoable() {
+        for (int i = 0; i < size; i++) {
+            int index = (head - 1 - i + 2 * capacity) % capacity;
+            if (slots[index].isUndoable() && !slots[index].isUndone()) {
+                return &slots[index];
+            }
         }
-        ss << "]";
-        return ss.str();
+        return nullptr;
     }
 
     /**
-     * Get recent N activities as JSON
-     * 
-     * @param n Number of recent activities to get
-     * 
+     * Get all retained activities as JSON array (newest first)
+     *
      * Time: O(n) | Space: O(n)
      */
-    std::string getRecentActivitiesJSON(int n) const {
-        std::stringstream ss;
-        ss << "[";
-        ActivityNode* current = top;
-        int count = 0;
-        bool first = true;
-        while (current != nullptr && count < n) {
-            if (!first) ss << ",";
-            ss << current->data.toJSON();
-            first = false;
-            current = current->next;
-            count++;
-        }
-        ss << "]";
-        return ss.str();
+    std::string getAllActivitiesJSON() const {
+        return getRecentActivitiesJSON(size);
     }
 
-private:
     /**
-     * Remove oldest activity (at bottom of stack)
-     * Called when stack exceeds maxSize
-     * 
-     * Time: O(n) - must traverse to second-to-last node
+     * Get recent N activities as JSON (newest first), reading
+     * backwards from the write head
+     *
+     * @param n Number of recent activities to get
+     *
+     * Time: O(n) | Space: O(n)
      */
-    void trimOldest() {
-        if (top == nullptr || top->next == nullptr) return;
+    std::string getRecentActivitiesJSON(int n) const {
+        int count = (n < size) ? n : size;
+        if (count < 0) count = 0;
 
-        ActivityNode* current = top;
-        while (current->next->next != nullptr) {
-            current = current->next;
+        std::string out;
+        out.reserve(static_cast<std::size_t>(count) * 160 + 2);
+        out += "[";
+        for (int i = 0; i < count; i++) {
+            if (i > 0) out += ",";
+            int index = (head - 1 - i + 2 * capacity) % capacity;
+            slots[index].appendJSON(out);
         }
-        delete current->next;
-        current->next = nullptr;
-        size--;
+        out += "]";
+        return out;
     }
 };
 
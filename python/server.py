@@ -686,6 +686,11 @@ if not USING_CPP:
 
 if USING_CPP:
     manager = patient_system.PatientManager()
+    # Recover from the binary snapshot + WAL and log all mutations
+    if hasattr(manager, 'enable_durability'):
+        recovery = json.loads(manager.enable_durability(DATA_DIR))
+        print(f"✓ Durability enabled: {recovery.get('recoveredPatients', 0)} patients "
+              f"recovered, {recovery.get('walOpsReplayed', 0)} WAL ops replayed")
 else:
     manager = PatientManagerPython()
 
@@ -727,6 +732,47 @@ def get_patients_sorted():
     result = manager.get_patients_sorted()
     return jsonify(json.loads(result) if isinstance(result, str) else result)
 
+@app.route('/api/patients/page', methods=['GET'])
+def get_patients_page():
+    """Get one page of patients (avoids materializing the full listing)"""
+    offset = request.args.get('offset', 0, type=int)
+    limit = request.args.get('limit', 50, type=int)
+    if hasattr(manager, 'get_patients'):
+        # C++ backend renders only the requested page
+        return jsonify(json.loads(manager.get_patients(offset, limit)))
+    # Python fallback: slice the full listing
+    patients = json.loads(manager.get_all_patients())
+    return jsonify({
+        "success": True,
+        "offset": offset,
+        "limit": limit,
+        "total": len(patients),
+        "patients": patients[offset:offset + limit]
+    })
+
+@app.route('/api/patients/stream', methods=['GET'])
+def stream_patients():
+    """Stream all patients as chunked JSON (C++ backend only)"""
+    chunk_size = request.args.get('chunk_size', 1000, type=int)
+    if not hasattr(manager, 'stream_patients'):
+        result = manager.get_all_patients()
+        return app.response_class(result, mimetype='application/json')
+
+    def generate():
+        yield b'['
+        first = True
+        for chunk in manager.stream_patients(chunk_size):
+            body = chunk[1:-1]  # strip the chunk's own [ ]
+            if not body:
+                continue
+            if not first:
+                yield b','
+            yield body
+            first = False
+        yield b']'
+
+    return app.response_class(generate(), mimetype='application/json')
+
 @app.route('/api/patients/search', methods=['GET'])
 def search_patients_by_name():
     """Search patients by name"""
@@ -736,6 +782,44 @@ def search_patients_by_name():
     result = manager.search_by_name(name)
     return jsonify(json.loads(result))
 
+@app.route('/api/patients/by-disease', methods=['GET'])
+def search_patients_by_disease():
+    """Find all patients with a disease (secondary index, C++ backend only)"""
+    disease = request.args.get('disease', '')
+    if not disease:
+        return jsonify({"success": False, "message": "Disease query is required"})
+    if not hasattr(manager, 'search_by_disease'):
+        patients = json.loads(manager.get_all_patients())
+        matches = [p for p in patients if p.get('disease') == disease]
+        return jsonify({"success": True, "count": len(matches), "patients": matches})
+    result = manager.search_by_disease(disease)
+    return jsonify(json.loads(result))
+
+@app.route('/api/aggregates', methods=['GET'])
+def get_aggregates():
+    """Dashboard aggregates (C++ backend computes these incrementally)"""
+    if not hasattr(manager, 'get_aggregates'):
+        patients = json.loads(manager.get_all_patients())
+        diseases, genders, dates = {}, {}, {}
+        ages = {("%d-%d" % (b * 10, b * 10 + 9)) if b < 10 else "100+": 0
+                for b in range(11)}
+        for p in patients:
+            diseases[p['disease']] = diseases.get(p['disease'], 0) + 1
+            genders[p['gender']] = genders.get(p['gender'], 0) + 1
+            dates[p['appointmentDate']] = dates.get(p['appointmentDate'], 0) + 1
+            bucket = min(max(p['age'], 0) // 10, 10)
+            key = "100+" if bucket == 10 else "%d-%d" % (bucket * 10, bucket * 10 + 9)
+            ages[key] += 1
+        return jsonify({
+            "success": True,
+            "totalPatients": len(patients),
+            "diseases": diseases,
+            "genders": genders,
+            "ageHistogram": ages,
+            "appointmentDates": dict(sorted(dates.items()))
+        })
+    return jsonify(json.loads(manager.get_aggregates()))
+
 @app.route('/api/patient', methods=['POST'])
 def add_patient():
     """Add a new patient"""
@@ -852,8 +936,25 @@ def load_sample_data():
 
 @app.route('/api/export', methods=['GET'])
 def export_data():
-    """Export all data as JSON"""
-    data = manager.export_data()
+    """Export all data as JSON (the nightly-export path)"""
+    if hasattr(manager, 'export_patients_json'):
+        # C++ backend: the patient array is rendered in parallel
+        # (sharded across cores) and assembled here without ever
+        # parsing it in Python
+        threads = request.args.get('threads', default=0, type=int)
+        patients_json = manager.export_patients_json(threads).decode('utf-8')
+        stats = json.loads(manager.get_statistics())
+        envelope = json.loads(manager.get_waiting_list())
+        data = ('{"patients":' + patients_json +
+                ',"queue":' + json.dumps(envelope.get('waitingList', [])) +
+                ',"statistics":' + json.dumps({
+                    "totalPatients": stats.get('totalPatients', 0),
+                    "queueSize": stats.get('queueSize', 0),
+                }) +
+                ',"exportedAt":' +
+                json.dumps(datetime.now().strftime("%Y-%m-%d %H:%M:%S")) + '}')
+    else:
+        data = manager.export_data()
     return app.response_class(
         response=data,
         status=200,
@@ -861,6 +962,13 @@ def export_data():
         headers={'Content-Disposition': 'attachment; filename=patients_export.json'}
     )
 
+@app.route('/api/snapshot', methods=['POST'])
+def save_snapshot():
+    """Write a compact binary snapshot and truncate the WAL (C++ backend only)"""
+    if not hasattr(manager, 'save_snapshot'):
+        return jsonify({"success": False, "message": "Snapshots require the C++ backend"})
+    return jsonify(json.loads(manager.save_snapshot()))
+
 @app.route('/api/clear', methods=['POST'])
 def clear_all_data():
     """Clear all data (use with caution!)"""